@@ -8,16 +8,21 @@
 void init_beehive_process(ProcessInfo* process_info, int id);// Inicializar el proceso de la apicultura de abejas
 void cleanup_beehive_process(ProcessInfo* process_info);// Limpiar el proceso de la apicultura de abejas
 
-// Control de hilos del proceso
-void start_process_thread(ProcessInfo* process_info);// Iniciar el hilo del proceso
-void stop_process_thread(ProcessInfo* process_info);// Detener el hilo del proceso
-void* process_main_thread(void* arg);// El hilo del proceso principal (se ejecuta en un nuevo proceso)
+// Control de ejecución del proceso (ciclos ejecutados por el pool de trabajadores)
+void start_process_thread(ProcessInfo* process_info);// Dejar el proceso listo para recibir ciclos
+void stop_process_thread(ProcessInfo* process_info);// Esperar a que termine el ciclo en curso del proceso
+void submit_hive_tick(ProcessInfo* process_info);// Encolar un ciclo de la colmena en el pool de trabajadores
+void run_hive_tick(void* arg);// Ejecutar un ciclo de trabajo de la colmena (tarea del pool)
+void run_hive_epoch_tick(ProcessInfo* process_info);// Ejecutar un ciclo de la colmena en el modo por épocas (sin planificador)
 
 // Gestión de cámaras y celdas
 void init_chambers(ProcessInfo* process_info);/// Inicializar las cámaras
 bool is_egg_position(int i, int j);// Comprobar si una posición es válida para la extracción de huevos
 bool find_empty_cell_for_egg(Chamber* chamber, int* x, int* y);// Buscar una celda vacía para la extracción de huevos
 bool find_empty_cell_for_honey(Chamber* chamber, int* x, int* y);// Buscar una celda vacía para la extracción de miel
+void refresh_chamber_space(Beehive* hive, int c);// Actualizar el índice de cámaras con sitio para huevos y miel
+void init_hatch_wheel(HatchWheel* wheel, clock_ns_t now);// Vaciar la rueda de eclosión de una colmena
+void schedule_egg_hatch(Beehive* hive, int c, int index, clock_ns_t lay_time);// Encolar la eclosión de un huevo recién puesto
 
 // Gestión de recursos y producción
 void manage_honey_production(ProcessInfo* process_info);// Gestionar la producción de miel
@@ -26,7 +31,9 @@ void manage_bee_lifecycle(ProcessInfo* process_info);// Gestionar la vida de las
 
 // Gestión de abejas
 void handle_bee_death(ProcessInfo* process_info, int bee_index);// Manejar la muerte de una abeja
-void create_new_bee(ProcessInfo* process_info, BeeType type);// Crear una abeja nueva
+BeeHandle create_new_bee(ProcessInfo* process_info, BeeType type);// Crear una abeja nueva en un hueco libre (BEE_HANDLE_NONE si la colmena está llena)
+BeeHandle bee_handle(const BeeColony* bees, int slot);// Referencia a la abeja que ocupa un hueco
+int bee_slot(const BeeColony* bees, BeeHandle handle);// Hueco de una abeja (-1 si la referencia ya no es válida)
 void process_eggs_hatching(ProcessInfo* process_info);// Procesar los huevos que están embarazados
 void process_queen_egg_laying(ProcessInfo* process_info);// Procesar los huevos que están embarazados
 
@@ -43,4 +50,9 @@ bool check_new_queen(ProcessInfo* process_info);// Comprobar si hay una abeja re
 // Actualizar el contador de abejas + miel
 void update_bees_and_honey_count(Beehive* hive);// Actualizar el contador de abejas y miel
 
+// Mantenimiento de los agregados (los únicos puntos que modifican abejas y miel de la colmena)
+void add_hive_honey(Beehive* hive, int amount);// Sumar miel a la colmena y actualizar la clave de FSJ
+void count_bee_birth(Beehive* hive, BeeType type);// Registrar un nacimiento en los agregados
+void count_bee_death(Beehive* hive, BeeType type);// Registrar una muerte en los agregados
+
 #endif
\ No newline at end of file
@@ -0,0 +1,92 @@
+#ifndef CELL_MASK_H
+#define CELL_MASK_H
+
+#include "../types/beehive_types.h" // Tipos de colmenas
+
+// Operaciones sobre los mapas de celdas de 128 bits (en línea: se usan en los bucles de puesta y producción)
+
+static const CellMask EGG_ZONE = {{EGG_ZONE_MASK_LO, EGG_ZONE_MASK_HI}}; // Celdas que admiten huevos
+static const CellMask HONEY_ZONE = {{HONEY_ZONE_MASK_LO, HONEY_ZONE_MASK_HI}}; // Celdas que admiten miel
+
+static inline int cell_index(int row, int column) {// Bit de una celda
+    return row * MAX_CHAMBER_SIZE + column;// Orden por filas
+}
+
+static inline int egg_cell_slot(int index) {// Posición de una celda de huevos dentro de la zona (número de celdas de la zona anteriores)
+    if (index < 64) return __builtin_popcountll(EGG_ZONE_MASK_LO & ((1ULL << index) - 1));// Solo la palabra baja
+    return __builtin_popcountll(EGG_ZONE_MASK_LO) + __builtin_popcountll(EGG_ZONE_MASK_HI & ((1ULL << (index - 64)) - 1));// Palabra baja completa y parte de la alta
+}
+
+static inline bool cell_mask_test(const CellMask* mask, int index) {// Comprobar si una celda está marcada
+    return (mask->words[index >> 6] >> (index & 63)) & 1;// Bit de la celda
+}
+
+static inline void cell_mask_set(CellMask* mask, int index) {// Marcar una celda
+    mask->words[index >> 6] |= 1ULL << (index & 63);// Encender el bit
+}
+
+static inline void cell_mask_clear(CellMask* mask, int index) {// Desmarcar una celda
+    mask->words[index >> 6] &= ~(1ULL << (index & 63));// Apagar el bit
+}
+
+static inline void cell_mask_remove(CellMask* mask, const CellMask* cells) {// Desmarcar en bloque un conjunto de celdas
+    mask->words[0] &= ~cells->words[0];// Palabra baja
+    mask->words[1] &= ~cells->words[1];// Palabra alta
+}
+
+static inline int cell_mask_count(const CellMask* mask) {// Contar las celdas marcadas
+    return __builtin_popcountll(mask->words[0]) + __builtin_popcountll(mask->words[1]);// Suma de ambas palabras
+}
+
+static inline bool cell_mask_empty(const CellMask* mask) {// Comprobar si no hay celdas marcadas
+    return (mask->words[0] | mask->words[1]) == 0;// Ambas palabras a cero
+}
+
+static inline int cell_mask_first_free(const CellMask* used, const CellMask* zone) {// Primera celda libre de una zona (-1 si está llena)
+    for (int w = 0; w < CELL_MASK_WORDS; w++) {// Recorrer las palabras
+        uint64_t free_bits = zone->words[w] & ~used->words[w];// Celdas de la zona sin ocupar
+        if (free_bits) return (w << 6) + __builtin_ctzll(free_bits);// La menor celda libre
+    }
+    return -1;// Zona llena
+}
+
+static inline int cell_mask_pop(CellMask* mask) {// Extraer la menor celda marcada (-1 si no hay ninguna)
+    for (int w = 0; w < CELL_MASK_WORDS; w++) {// Recorrer las palabras
+        if (mask->words[w]) {// Comprobar si la palabra tiene celdas
+            int bit = __builtin_ctzll(mask->words[w]);// Menor bit encendido
+            mask->words[w] &= mask->words[w] - 1;// Apagarlo
+            return (w << 6) + bit;// Índice de la celda
+        }
+    }
+    return -1;// Mapa vacío
+}
+
+static inline int chamber_set_pop(ChamberSet* set) {// Extraer la menor cámara del conjunto (el llamador comprueba que no esté vacío)
+    int chamber = __builtin_ctz(*set);// Menor bit encendido
+    *set &= *set - 1;// Apagarlo
+    return chamber;// Índice de la cámara
+}
+
+// Ocupar las primeras count celdas libres de una zona; devuelve cuántas se ocuparon y las deja en filled (si no es NULL)
+static inline int cell_mask_fill(CellMask* used, const CellMask* zone, int count, CellMask* filled) {
+    int taken = 0;// Celdas ocupadas
+    for (int w = 0; w < CELL_MASK_WORDS; w++) {// Recorrer las palabras
+        uint64_t free_bits = zone->words[w] & ~used->words[w];// Celdas libres de la zona
+        uint64_t take = free_bits;// Celdas a ocupar en esta palabra
+        int available = __builtin_popcountll(free_bits);// Celdas libres disponibles
+        if (available > count - taken) {// Solo se necesitan las menores
+            take = 0;// Se eligen una a una
+            for (int k = count - taken; k > 0; k--) {// Tantas como falten
+                take |= free_bits & -free_bits;// Menor celda libre
+                free_bits &= free_bits - 1;// Quitarla de las libres
+            }
+            available = count - taken;// Se ocupan las que faltan
+        }
+        used->words[w] |= take;// Ocupar en bloque
+        if (filled) filled->words[w] = take;// Celdas recién ocupadas
+        taken += available;// Contar las ocupadas
+    }
+    return taken;// Total ocupado
+}
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdbool.h> // Biblioteca de tipos de datos
+#include <time.h> // Biblioteca de tiempo
+#include "../types/clock_types.h" // Tipos de reloj
+
+// Lecturas del reloj monótono
+clock_ns_t clock_now_ns(void);// Obtener la hora monótona precisa en nanosegundos
+clock_ns_t clock_coarse_now_ns(void);// Obtener la hora monótona aproximada (barata, para bucles calientes)
+clock_ns_t clock_wall_now_ns(void);// Obtener la hora monótona real aunque esté activo el tiempo virtual
+
+// Tiempo virtual
+void clock_use_virtual(bool enabled);// Activar o desactivar el tiempo virtual (antes de arrancar la simulación)
+bool clock_is_virtual(void);// Comprobar si el tiempo virtual está activo
+void clock_advance_to(clock_ns_t t);// Avanzar el tiempo virtual hasta una marca (nunca retrocede)
+
+// Conversiones
+clock_ns_t clock_ms_to_ns(int64_t milliseconds);// Convertir milisegundos a nanosegundos
+double clock_elapsed_ms(clock_ns_t since, clock_ns_t now);// Obtener los milisegundos transcurridos entre dos marcas
+double clock_elapsed_seconds(clock_ns_t since, clock_ns_t now);// Obtener los segundos transcurridos entre dos marcas
+struct timespec clock_to_timespec(clock_ns_t t);// Convertir una marca a timespec (para esperas con CLOCK_MONOTONIC)
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include "../types/config_types.h" // Tipos de configuración
+
+void init_simulation_config(SimulationConfig* config);// Valores por defecto de la configuración
+bool parse_command_line(SimulationConfig* config, int argc, char* argv[]);// Leer la configuración de la línea de comandos
+void print_usage(const char* program);// Imprimir la ayuda de la línea de comandos
+
+#endif
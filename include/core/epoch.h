@@ -0,0 +1,9 @@
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include "../types/epoch_types.h" // Tipos del modo por épocas
+
+// Ejecución por épocas (sin planificador: todas las colmenas avanzan un ciclo por época)
+int run_epoch(ProcessInfo** processes, int count);// Avanzar un ciclo cada colmena en el pool y esperar a la barrera; devuelve los ciclos ejecutados
+
+#endif
@@ -7,12 +7,15 @@
 
 // Inicialización y limpieza
 void init_file_manager(void);// Inicializar el gestor de archivos
+void cleanup_file_manager(void);// Escribir y liberar la copia en memoria de los PCB
 
 // Gestión de PCB
 void save_pcb(ProcessControlBlock* pcb);// Guardar el PCB de un proceso en el archivo
 void update_pcb_state(ProcessControlBlock* pcb, ProcessState new_state, Beehive* hive);// Actualizar el estado del PCB de un proceso
 void init_pcb(ProcessControlBlock* pcb, int process_id);// Inicializar el PCB de un proceso
 void create_pcb_for_beehive(ProcessInfo* process_info);// Crear el PCB de un proceso para la apicultura de abejas
+void begin_pcb_batch(void);// Abrir un lote de altas de PCB (el archivo se escribe al cerrarlo)
+void end_pcb_batch(void);// Cerrar un lote de altas de PCB y escribir el archivo
 
 // Gestión de tabla de procesos
 void init_process_table(ProcessTable* table);// Inicializar la tabla de procesos
@@ -0,0 +1,16 @@
+#ifndef HIVE_SLAB_H
+#define HIVE_SLAB_H
+
+#include "../types/hive_slab_types.h" // Tipos del asignador de colmenas
+
+// Reserva y liberación de bloques
+ProcessInfo* hive_slab_alloc(void);// Reservar el bloque de una colmena y devolver su proceso a cero (NULL sin memoria)
+void hive_slab_free(ProcessInfo* process);// Devolver el bloque de una colmena a la lista libre
+void cleanup_hive_slabs(void);// Liberar todos los slabs (con todas las colmenas ya devueltas)
+
+// Partes del bloque de una colmena
+Beehive* hive_slab_hive(ProcessInfo* process);// Colmena del bloque
+ProcessControlBlock* hive_slab_pcb(ProcessInfo* process);// PCB del bloque
+sem_t* hive_slab_sem(ProcessInfo* process);// Semáforo del bloque
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef POLEN_KERNEL_H
+#define POLEN_KERNEL_H
+
+#include <stdint.h> // Tipos enteros de tamaño fijo
+#include "../types/beehive_types.h" // Tipos de colmenas
+
+// Núcleo de recolección de polen: suma draws[i] a polen_collected[i] en count carriles (múltiplo de 8),
+// devuelve el polen total y deja en reached las abejas cuyo polen alcanzó su límite de vida
+int collect_polen(int32_t* polen_collected, const int32_t* draws, const int32_t* lifetime, int count, BeeSet* reached);// Ejecutar el núcleo elegido para la CPU
+const char* polen_kernel_name(void);// Nombre del núcleo elegido (avx2, sse2 o scalar)
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef POLICIES_H
+#define POLICIES_H
+
+#include "../types/scheduler_types.h" // Tipos de planificación
+
+// Registro de políticas
+const SchedulerPolicyOps* get_policy_ops(SchedulingPolicy policy);// Obtener las operaciones de una política
+bool parse_scheduling_policy(const char* name, SchedulingPolicy* policy);// Convertir un nombre corto en política
+
+#endif
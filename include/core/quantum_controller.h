@@ -0,0 +1,17 @@
+#ifndef QUANTUM_CONTROLLER_H
+#define QUANTUM_CONTROLLER_H
+
+#include "../types/scheduler_types.h" // Tipos de planificación
+
+// Inicialización
+void init_quantum_controller(QuantumController* controller, QuantumMode mode, clock_ns_t now);// Inicializar el controlador en un modo
+
+// Medición
+void quantum_controller_record(QuantumController* controller, ProcessState old_state, ProcessState new_state, double ready_wait_seconds, double io_wait_seconds);// Registrar una transición de estado y las esperas que sumó al PCB
+bool quantum_controller_sample(QuantumController* controller, SchedulingPolicy policy, clock_ns_t now);// Cerrar la ventana si venció y actualizar las medias móviles
+
+// Decisiones
+int quantum_controller_tune_quantum(const QuantumController* controller, int quantum);// Calcular el siguiente quantum (ms) a partir de las medidas
+bool quantum_controller_should_switch(const QuantumController* controller, SchedulingPolicy current, SchedulingPolicy alternative);// Decidir si conviene cambiar a la otra política
+
+#endif
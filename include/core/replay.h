@@ -0,0 +1,9 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "../types/replay_types.h" // Tipos de la reproducción
+
+// Reproducción de trazas
+int run_trace_replay(const char* path, const char* policy_name);// Reproducir una traza con una política ("all" compara todas); devuelve el código de salida
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include "../types/rng_types.h" // Tipos del generador
+
+// Semilla maestra
+void rng_set_master_seed(uint64_t seed);// Fijar la semilla de la que se derivan todos los flujos
+uint64_t rng_master_seed(void);// Obtener la semilla maestra
+
+// Flujos
+void rng_stream_init(RngStream* rng, uint64_t stream_id);// Inicializar un flujo independiente a partir de la semilla maestra
+uint64_t rng_next(RngStream* rng);// Obtener 64 bits aleatorios
+int rng_range(RngStream* rng, int min, int max);// Obtener un entero uniforme entre min y max (inclusive)
+void rng_fill_range(RngStream* rng, int* out, int count, int min, int max);// Llenar un arreglo con enteros uniformes entre min y max
+
+#endif
@@ -4,29 +4,44 @@
 #include "../types/scheduler_types.h" // Tipos de planificación
 
 // Inicialización y limpieza
-void init_scheduler(void);// Inicializar el planificador
-void cleanup_scheduler(void);// Limpiar el planificador
+void init_scheduler(SchedulingPolicy policy, bool auto_switch_policy, QuantumMode quantum_mode, int process_limit);// Inicializar el planificador con la política, el modo de quantum y el máximo de procesos
+void stop_scheduler(void);// Detener los hilos del planificador y el pool (antes de liberar los procesos)
+void cleanup_scheduler(void);// Limpiar el planificador (lo detiene si sigue en marcha)
 
 // Control de política de planificación
-void switch_scheduling_policy(void);// Cambiar la política de planificación
+void switch_scheduling_policy(void);// Alternar entre Round Robin y FSJ
+void set_scheduling_policy(SchedulingPolicy policy);// Cambiar a una política concreta y reordenar las colas
 void* policy_control_thread(void* arg);// El hilo del control de la política de planificación
+void scheduler_step(void);// Ejecutar una decisión completa del planificador (un ciclo del hilo de control)
 void update_quantum(void);// Actualizar la quantum del planificador
 
 // Gestión de colas y procesos
+void init_ready_queue(ReadyQueue* queue, int limit);// Inicializar una cola de listos vacía que crece hasta limit procesos
+void cleanup_ready_queue(ReadyQueue* queue);// Liberar una cola de listos
 void add_to_ready_queue(ProcessInfo* process);// Añadir un proceso a la cola de procesos
+bool ready_queue_push(ReadyQueue* queue, ProcessInfo* process, clock_ns_t now);// Insertar un proceso en una cola de listos concreta según la política actual
+ProcessInfo* ready_queue_pop(ReadyQueue* queue);// Extraer la cima de una cola de listos concreta
 void remove_from_ready_queue(ProcessInfo* process);// Eliminar un proceso de la cola de procesos
-ProcessInfo* get_next_ready_process(void);// Obtener el siguiente proceso en la cola de procesos
-void schedule_process(void);// Programar el siguiente proceso en la cola de procesos
+ProcessInfo* get_next_ready_process(DispatchSlot* slot);// Obtener el siguiente proceso para un núcleo (roba de otro si su cola está vacía)
+void update_ready_queue_priority(ProcessInfo* process);// Reubicar un proceso en la cola de listos tras cambiar su tamaño
+void schedule_process(void);// Programar el siguiente proceso en cada núcleo
+void dispatch_hive_ticks(void);// Encolar un ciclo de trabajo para cada colmena en ejecución
+int count_ready_processes(void);// Contar los procesos listos en todos los núcleos
+void publish_ready_process(ProcessInfo* process);// Publicar sin bloqueo un proceso listo (fin de E/S o colmena nueva)
+int drain_ready_handoff(void);// Mover en lote los procesos publicados a las colas de listos
 
 // Gestión de estado de proceso
 void update_process_state(ProcessInfo* process, ProcessState new_state);// Actualizar el estado de un proceso
-void preempt_current_process(ProcessState new_state);// Preemptuar el proceso actual
-void resume_process(ProcessInfo* process);// Reanudar un proceso suspendido
-
-// Gestión de FSJ
-void sort_ready_queue_fsj(void);// Ordenar la cola de procesos según su prioridad
-bool should_preempt_fsj(ProcessInfo* new_process);// Comprobar si se debe preemptuar el proceso actual
-void handle_fsj_preemption(void);// Manejar la preemptión del proceso actual según la política de planificación
+void preempt_current_process(DispatchSlot* slot, ProcessState new_state);// Preemptuar el proceso actual de un núcleo
+void resume_process(ProcessInfo* process);// Reanudar un proceso suspendido (despierta su ciclo de inmediato)
+void record_dispatch_latency(clock_ns_t latency);// Registrar la latencia entre un despacho y el inicio del ciclo
+double average_dispatch_latency_ms(void);// Obtener la latencia media de despacho en milisegundos
+
+// Gestión de la expulsión
+void rebuild_ready_queue(ReadyQueue* queue);// Reconstruir el montículo de listos según la política actual
+void age_ready_queue(ReadyQueue* queue, clock_ns_t now);// Envejecer los procesos en espera y reordenar la cola si cambió alguna prioridad
+bool should_preempt(DispatchSlot* slot, ProcessInfo* new_process);// Comprobar si la política expulsa al proceso actual de un núcleo
+void handle_preemption(void);// Manejar la expulsión del proceso actual según la política de planificación
 
 // Gestión de E/S
 void init_io_queue(void);// Inicializar la cola de E/S
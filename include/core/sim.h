@@ -0,0 +1,17 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdbool.h> // Biblioteca de tipos de datos
+#include <signal.h> // Biblioteca de señales
+#include "../types/sim_types.h" // Tipos de la simulación
+
+// Inicialización y limpieza
+void init_sim_events(void);// Inicializar la cola global de eventos
+void cleanup_sim_events(void);// Liberar la cola global de eventos
+
+// Gestión de eventos
+void sim_schedule(clock_ns_t time, SimEventFn fn, void* arg);// Programar un evento único
+void sim_schedule_periodic(clock_ns_t first, clock_ns_t period, SimEventFn fn, void* arg);// Programar un evento repetitivo
+long long sim_run_until(clock_ns_t end, volatile sig_atomic_t* running);// Ejecutar eventos saltando el tiempo virtual hasta end; devuelve los eventos ejecutados
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "../types/thread_pool_types.h" // Tipos del pool de trabajadores
+
+// Inicialización y limpieza
+void init_thread_pool(ThreadPool* pool, int worker_count);// Inicializar el pool y arrancar sus trabajadores
+void shutdown_thread_pool(ThreadPool* pool);// Terminar las tareas pendientes y detener los trabajadores
+
+// Gestión de tareas
+bool thread_pool_submit(ThreadPool* pool, ThreadPoolTaskFn function, void* arg);// Encolar una tarea (false si el pool ya se está cerrando)
+void thread_pool_wait_idle(ThreadPool* pool);// Esperar a que no queden tareas pendientes ni en ejecución
+
+#endif
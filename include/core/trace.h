@@ -0,0 +1,17 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h> // Biblioteca de tipos de datos
+#include <stddef.h> // Tipos estándar
+#include "../types/trace_types.h" // Tipos de la traza
+
+// Grabación
+bool init_trace(const char* path, int slot_count);// Abrir el archivo de traza y escribir la cabecera
+void trace_event(TraceEventType type, int process, int slot, int value, int size);// Registrar un evento del planificador
+void close_trace(void);// Volcar los registros pendientes y cerrar la traza
+
+// Lectura
+TraceRecord* load_trace(const char* path, TraceHeader* header, size_t* count);// Leer una traza completa (el llamador libera el arreglo)
+const char* trace_event_name(TraceEventType type);// Obtener el nombre legible de un tipo de evento
+
+#endif
@@ -1,13 +1,15 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <stdio.h> // Biblioteca de entrada/salida estándar
 #include <json-c/json.h> // Biblioteca de JSON
 #include <time.h> // Biblioteca de tiempo
 #include <stdbool.h> // Biblioteca de tipos de datos
 #include <sys/types.h> // Biblioteca de tipos de datos
 
-// Funciones de números aleatorios
-int random_range(int min, int max);// Generar un número aleatorio entre min y max
+// Salida por ciclo (se suprime en el modo headless; los argumentos no se evalúan si está en silencio)
+extern bool quiet_output;// Indica si se suprime la salida por ciclo
+#define log_printf(...) do { if (!quiet_output) printf(__VA_ARGS__); } while (0)// Imprimir solo si no está activo el modo silencioso
 
 // Funciones de tiempo
 void delay_ms(int milliseconds);// Retrasar el programa por un número de milisegundos
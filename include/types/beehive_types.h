@@ -3,8 +3,12 @@
 
 #include <pthread.h> // Biblioteca de hilos
 #include <semaphore.h> // Biblioteca de semáforos
+#include <stdatomic.h> // Contadores atómicos
 #include <stdbool.h> // Biblioteca de tipos de datos
+#include <stdint.h> // Tipos enteros de tamaño fijo
 #include <time.h> // Biblioteca de tiempo
+#include "clock_types.h" // Tipos de reloj
+#include "rng_types.h" // Tipos del generador de números aleatorios
 #include "file_manager_types.h" // Tipos de gestión de archivos
 #include <signal.h> // Biblioteca de señales
 
@@ -13,6 +17,8 @@
 #define NUM_CHAMBERS 10 // Número de cámaras
 #define INITIAL_BEEHIVES 5 // Número inicial de colmenas
 #define MAX_BEEHIVES 40 // Número máximo de colmenas
+#define SIMULATION_TICK_MS 1000 // Periodo del ciclo principal de la simulación (ms)
+#define STATS_INTERVAL 5 // Intervalo de impresión de estadísticas (s)
 #define MIN_BEES 20 // Número mínimo de abejas
 #define MAX_BEES 40 // Número máximo de abejas
 #define MIN_HONEY 20 // Número mínimo de miel
@@ -27,7 +33,7 @@
 #define MAX_POLEN_PER_TRIP 5 // Polen máximo por colmena
 #define MIN_POLEN_LIFETIME 100 // Tiempo mínimo de vida de polen
 #define MAX_POLEN_LIFETIME 150 // Tiempo máximo de vida de polen
-#define MAX_EGG_HATCH_TIME 10 // Tiempo máximo de vida de huevos
+#define MAX_EGG_HATCH_TIME 10 // Tiempo máximo de vida de huevos (ms)
 
 // Constantes para la reina
 #define MIN_EGGS_PER_LAYING 120 // Número mínimo de huevos por colmena
@@ -45,55 +51,145 @@ typedef enum {
     WORKER // Trabajadora
 } BeeType;
 
-// Estructura de celda
+// Mapa de bits de las celdas de una cámara (bit = fila * MAX_CHAMBER_SIZE + columna)
+#define CHAMBER_CELLS (MAX_CHAMBER_SIZE * MAX_CHAMBER_SIZE) // Celdas por cámara (caben en 128 bits)
+#define CELL_MASK_WORDS 2 // Palabras de 64 bits por mapa
 typedef struct {
-    bool has_honey; // Indica si la celda tiene miel
-    bool has_egg; // Indica si la celda tiene huevos
-    time_t egg_lay_time; // Tiempo de vida de huevos
-} Cell;
+    uint64_t words[CELL_MASK_WORDS]; // Bits 0-63 y 64-127 (los bits 100-127 nunca se usan)
+} CellMask;
+
+_Static_assert(CHAMBER_CELLS <= CELL_MASK_WORDS * 64, "Las celdas de una cámara deben caber en un mapa");// Como mucho 11x11 celdas
+
+// Geometrías de la cámara: se elige una al compilar (-DCHAMBER_GEOMETRY=...) y sus zonas se calculan como constantes
+#define CHAMBER_GEOMETRY_CLASSIC 0 // Huevos en el centro (filas 3-8, con las filas centrales ensanchadas) y miel en el borde
+#define CHAMBER_GEOMETRY_BAND 1 // Huevos en las cuatro filas centrales completas y miel arriba y abajo
+#ifndef CHAMBER_GEOMETRY
+#define CHAMBER_GEOMETRY CHAMBER_GEOMETRY_CLASSIC // Geometría por defecto
+#endif
+
+// Columnas de huevos de cada fila: [EGG_ROW_FIRST(r), EGG_ROW_LAST(r)] (vacío si la primera queda detrás de la última)
+#if CHAMBER_GEOMETRY == CHAMBER_GEOMETRY_CLASSIC
+#define EGG_ROW_FIRST(r) ((r) < 2 || (r) > MAX_CHAMBER_SIZE - 3 ? MAX_CHAMBER_SIZE : ((r) == MAX_CHAMBER_SIZE / 2 - 1 || (r) == MAX_CHAMBER_SIZE / 2) ? 1 : 2) // Sin huevos fuera de las filas 3-8
+#elif CHAMBER_GEOMETRY == CHAMBER_GEOMETRY_BAND
+#define EGG_ROW_FIRST(r) ((r) < MAX_CHAMBER_SIZE / 2 - 2 || (r) > MAX_CHAMBER_SIZE / 2 + 1 ? MAX_CHAMBER_SIZE : 0) // Filas centrales completas
+#else
+#error "CHAMBER_GEOMETRY desconocida"
+#endif
+#define EGG_ROW_LAST(r) (MAX_CHAMBER_SIZE - 1 - EGG_ROW_FIRST(r)) // Zonas simétricas respecto a la columna central
+
+// Bits de las celdas [a, b] que caen en la palabra w de un mapa
+#define CELL_SPAN_FROM(a, w) ((a) > (w) * 64 ? (a) : (w) * 64) // Primera celda dentro de la palabra
+#define CELL_SPAN_TO(b, w) ((b) < (w) * 64 + 63 ? (b) : (w) * 64 + 63) // Última celda dentro de la palabra
+#define CELL_SPAN_WORD(a, b, w) (CELL_SPAN_FROM(a, w) > CELL_SPAN_TO(b, w) ? 0ULL : (~0ULL >> (63 - (CELL_SPAN_TO(b, w) - CELL_SPAN_FROM(a, w)))) << (CELL_SPAN_FROM(a, w) - (w) * 64)) // Tramo de bits
+#define EGG_ROW_WORD(r, w) ((r) < MAX_CHAMBER_SIZE ? CELL_SPAN_WORD((r) * MAX_CHAMBER_SIZE + EGG_ROW_FIRST(r), (r) * MAX_CHAMBER_SIZE + EGG_ROW_LAST(r), w) : 0ULL) // Huevos de una fila
+#define EGG_ZONE_WORD(w) (EGG_ROW_WORD(0, w) | EGG_ROW_WORD(1, w) | EGG_ROW_WORD(2, w) | EGG_ROW_WORD(3, w) | EGG_ROW_WORD(4, w) | EGG_ROW_WORD(5, w) | \
+    EGG_ROW_WORD(6, w) | EGG_ROW_WORD(7, w) | EGG_ROW_WORD(8, w) | EGG_ROW_WORD(9, w) | EGG_ROW_WORD(10, w)) // Todas las filas que caben en un mapa
+
+// Zonas de la cámara: la miel ocupa todas las celdas que no son de huevos
+#define EGG_ZONE_MASK_LO EGG_ZONE_WORD(0) // Zona de huevos, bits 0-63
+#define EGG_ZONE_MASK_HI EGG_ZONE_WORD(1) // Zona de huevos, bits 64-127
+#define HONEY_ZONE_MASK_LO (CELL_SPAN_WORD(0, CHAMBER_CELLS - 1, 0) & ~EGG_ZONE_MASK_LO) // Zona de miel, bits 0-63
+#define HONEY_ZONE_MASK_HI (CELL_SPAN_WORD(0, CHAMBER_CELLS - 1, 1) & ~EGG_ZONE_MASK_HI) // Zona de miel, bits 64-127
+
+#define EGG_ZONE_CELLS (__builtin_popcountll(EGG_ZONE_MASK_LO) + __builtin_popcountll(EGG_ZONE_MASK_HI)) // Celdas de la zona de huevos
+#define HONEY_ZONE_CELLS (__builtin_popcountll(HONEY_ZONE_MASK_LO) + __builtin_popcountll(HONEY_ZONE_MASK_HI)) // Celdas de la zona de miel
+_Static_assert(EGG_ZONE_CELLS >= MAX_EGGS_PER_CHAMBER, "La zona de huevos debe admitir MAX_EGGS_PER_CHAMBER");// La geometría debe tener sitio para los límites
+_Static_assert(HONEY_ZONE_CELLS >= MAX_HONEY_PER_CHAMBER, "La zona de miel debe admitir MAX_HONEY_PER_CHAMBER");// La geometría debe tener sitio para los límites
+
+// Celda de la zona de huevos: solo guarda lo que necesita la rueda de eclosión (la ocupación vive en los mapas)
+typedef struct {
+    uint16_t hatch_tick; // Ranura de eclosión relativa a la base de la rueda
+    uint16_t hatch_next; // Siguiente huevo de la misma ranura de la rueda de eclosión (HATCH_NONE si es el último)
+} EggCell;
 
 // Estructura de cámara
 typedef struct {
-    Cell cells[MAX_CHAMBER_SIZE][MAX_CHAMBER_SIZE]; // Matriz de celdas
+    CellMask egg_mask; // Celdas con huevo
+    CellMask honey_mask; // Celdas con miel
+    EggCell eggs[EGG_ZONE_CELLS]; // Datos de eclosión de las celdas de huevos, por orden dentro de la zona (protegidos por hatch_mutex)
     int honey_count; // Número de miel en la cámara
     int egg_count; // Número de huevos en la cámara
+    pthread_mutex_t mutex; // Mutex de la cámara (protege sus mapas, celdas y contadores)
 } Chamber;
 
-// Estructura de abeja
+// Conjunto de cámaras (bit c = cámara c)
+typedef uint32_t ChamberSet;
+_Static_assert(NUM_CHAMBERS <= 32, "ChamberSet necesita un bit por cámara");// Comprobar que caben todas las cámaras
+
+// Rueda de eclosión: los huevos se encolan al ponerse en la ranura de su fecha de eclosión
+#define HATCH_WHEEL_SLOTS 32 // Ranuras de la rueda (potencia de dos)
+#define HATCH_WHEEL_GRANULARITY_NS CLOCK_NS_PER_MS // Anchura de cada ranura
+#define HATCH_NONE UINT16_MAX // Fin de lista (los huevos se identifican por cámara * CHAMBER_CELLS + celda)
+_Static_assert(MAX_EGG_HATCH_TIME * CLOCK_NS_PER_MS / HATCH_WHEEL_GRANULARITY_NS < HATCH_WHEEL_SLOTS, "La rueda debe cubrir el tiempo de eclosión");// Ningún huevo da más de una vuelta
+_Static_assert(MAX_EGG_HATCH_TIME * CLOCK_NS_PER_MS / HATCH_WHEEL_GRANULARITY_NS < UINT16_MAX / 2, "Las ranuras relativas deben caber en 16 bits");// Margen para adelantar la base
+_Static_assert(NUM_CHAMBERS * CHAMBER_CELLS < HATCH_NONE, "Los identificadores de huevo deben caber en 16 bits");// Listas intrusivas de 16 bits
+
 typedef struct {
-    int id; // ID de la abeja
-    BeeType type; // Tipo de abeja
-    int polen_collected; // Polen recolectado
-    bool is_alive; // Indica si la abeja está viva
-    time_t last_collection_time; // Tiempo de vida de polen
-    time_t last_egg_laying_time; // Tiempo de vida de huevos
-} Bee;
-
-// Recursos de producción
+    uint16_t head[HATCH_WHEEL_SLOTS]; // Primer huevo de cada ranura
+    uint16_t tail[HATCH_WHEEL_SLOTS]; // Último huevo de cada ranura (se encola al final para conservar el orden de puesta)
+    uint64_t cursor; // Ranura absoluta desde la que falta revisar
+    uint64_t base; // Ranura absoluta a la que se refieren los hatch_tick de 16 bits (se adelanta antes de desbordarlos)
+} HatchWheel;
+
+// Abejas de una colmena por columnas (SoA): bitsets de estado y contadores contiguos para el núcleo vectorial de polen
+#define BEE_CAPACITY ((MAX_BEES + 7) & ~7) // Abejas por colmena redondeado a 8 carriles (un registro AVX2)
+_Static_assert(BEE_CAPACITY <= 64, "BeeSet necesita un bit por abeja");// Comprobar que caben todas las abejas
+
+typedef uint64_t BeeSet; // Conjunto de abejas (bit i = abeja i)
+
+// Referencia estable a una abeja: generación del hueco (bits 8+) e índice del hueco (bits 0-7)
+typedef uint32_t BeeHandle;
+#define BEE_HANDLE_NONE UINT32_MAX // Sin abeja (colmena llena)
+#define BEE_HANDLE_SLOT_BITS 8 // Bits del índice del hueco
+
 typedef struct {
-    int total_polen; // Polen total
-    int polen_for_honey; // Polen para convertir en miel
-    int total_polen_collected; // Polen recolectado
-    pthread_mutex_t polen_mutex; // Mutex para el acceso a polen
+    BeeSet alive; // Huecos ocupados por abejas vivas (el resto del rango 0..MAX_BEES-1 está libre)
+    BeeSet workers; // Abejas obreras (el resto son reinas)
+    clock_ns_t last_collection_time; // Última recolección de polen (común a toda la pasada)
+    int32_t polen_collected[BEE_CAPACITY]; // Polen recolectado por cada abeja
+    int32_t polen_lifetime[BEE_CAPACITY]; // Polen que recolecta cada abeja antes de morir (se sortea al nacer)
+    uint16_t generation[BEE_CAPACITY]; // Generación de cada hueco (aumenta con cada muerte e invalida las referencias antiguas)
+} BeeColony;
+
+// Recursos de producción (atómicos: la recolección suma y la producción de miel consume sin bloqueos)
+typedef struct {
+    atomic_int total_polen; // Polen total
+    atomic_int polen_for_honey; // Polen para convertir en miel
+    atomic_int total_polen_collected; // Polen recolectado
 } ProductionResources;
 
+// Agregados de la colmena: se actualizan en cada nacimiento y muerte, de modo que leerlos es O(1)
+typedef struct {
+    int queens; // Reinas vivas
+    int alive_workers; // Obreras vivas
+    int dead_workers; // Obreras muertas (acumulado; sus huecos se reutilizan)
+} HiveAggregates;
+
 // Estructura base de colmena
+// Orden de bloqueo: hatch_mutex y bees_mutex nunca se toman con el mutex de una cámara retenido, y nunca se retienen dos cámaras
 typedef struct {
     int id; // ID de la colmena
-    int bee_count; // Número de abejas en la colmena
-    int honey_count; // Número de miel en la colmena
-    int egg_count; // Número de huevos en la colmena
+    int bee_count; // Número de abejas en la colmena (protegido por bees_mutex)
+    atomic_int honey_count; // Número de miel en la colmena
+    atomic_int egg_count; // Número de huevos en la colmena
     int hatched_eggs; // Número de huevos que han nacido
-    int dead_bees; // Número de abejas muertas
-    int born_bees; // Número de abejas nacidas
+    int dead_bees; // Número de abejas muertas (protegido por bees_mutex)
+    int born_bees; // Número de abejas nacidas (protegido por bees_mutex)
     int produced_honey; // Suma de honey_count de todos los bees
-    int bees_and_honey_count;  // Suma de bee_count + honey_count para el FSJ
-    Bee* bees; // Array de bees
-    Chamber chambers[NUM_CHAMBERS]; // Array de chambers
-    pthread_mutex_t chamber_mutex; // Mutex para el acceso a chambers
+    atomic_int bees_and_honey_count;  // Suma de bee_count + honey_count para el FSJ (se mantiene por diferencias)
+    HiveAggregates aggregates; // Conteos de abejas por tipo (protegido por bees_mutex)
+    BeeColony bees; // Abejas de la colmena (por columnas, protegido por bees_mutex)
+    Chamber chambers[NUM_CHAMBERS]; // Array de chambers (cada una con su mutex)
+    _Atomic ChamberSet egg_space; // Cámaras con sitio para huevos (bit c = cámara c)
+    _Atomic ChamberSet honey_space; // Cámaras con sitio para miel (bit c = cámara c)
+    HatchWheel hatch_wheel; // Huevos pendientes de eclosionar ordenados por fecha (protegido por hatch_mutex)
+    pthread_mutex_t bees_mutex; // Mutex de las abejas y sus agregados
+    pthread_mutex_t hatch_mutex; // Mutex de la rueda de eclosión
     ProductionResources resources; // Recursos de producción
     volatile sig_atomic_t should_terminate; // Indica si se debe terminar
-    bool should_create_new_hive; // Indica si se debe crear una nueva colmena
+    atomic_bool should_create_new_hive; // Indica si se debe crear una nueva colmena
+    RngStream rng; // Flujo aleatorio de la colmena (inicialización y recolección de polen)
+    RngStream brood_rng; // Flujo aleatorio de la cría (puesta, eclosión y nacimientos), independiente de la recolección
 } Beehive;
 
 #endif
\ No newline at end of file
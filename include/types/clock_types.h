@@ -0,0 +1,14 @@
+#ifndef CLOCK_TYPES_H
+#define CLOCK_TYPES_H
+
+#include <stdint.h> // Tipos enteros de tamaño fijo
+
+// Constantes de conversión de tiempo
+#define CLOCK_NS_PER_MS 1000000LL // Nanosegundos por milisegundo
+#define CLOCK_NS_PER_SEC 1000000000LL // Nanosegundos por segundo
+#define CLOCK_VIRTUAL_EPOCH CLOCK_NS_PER_SEC // Inicio del tiempo virtual (distinto de 0, que significa "sin marca")
+
+// Marca de tiempo monótona en nanosegundos (con signo para restar sin sorpresas)
+typedef int64_t clock_ns_t;
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef CONFIG_TYPES_H
+#define CONFIG_TYPES_H
+
+#include <stdint.h> // Tipos enteros de tamaño fijo
+#include <stdbool.h> // Biblioteca de tipos de datos
+#include "scheduler_types.h" // Tipos de planificación
+
+#define DEFAULT_VIRTUAL_DURATION 3600.0 // Segundos virtuales simulados si no se indica --duration
+
+// Configuración de una ejecución (línea de comandos)
+typedef struct {
+    int initial_hives; // Número de colmenas iniciales
+    int max_hives; // Número máximo de colmenas
+    double duration_seconds; // Duración de la simulación en segundos (0 = hasta Ctrl+C en tiempo real)
+    bool virtual_time; // Indica si se simula en tiempo virtual
+    bool epoch_mode; // Indica si todas las colmenas avanzan a la vez por épocas, sin planificador (implica tiempo virtual)
+    bool has_seed; // Indica si se fijó la semilla maestra
+    uint64_t seed; // Semilla maestra
+    bool has_policy; // Indica si se fijó una política (desactiva la alternancia automática)
+    SchedulingPolicy policy; // Política de planificación fija
+    QuantumMode quantum_mode; // Modo del quantum
+    bool headless; // Sin salida por ciclo, solo el resumen final de métricas
+    const char* metrics_path; // Archivo JSON de métricas (NULL = salida estándar)
+    const char* replay_path; // Traza a reproducir en lugar de simular (NULL = simular)
+    const char* replay_policy; // Política de la reproducción (NULL = todas)
+} SimulationConfig;
+
+#endif
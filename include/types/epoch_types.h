@@ -0,0 +1,17 @@
+#ifndef EPOCH_TYPES_H
+#define EPOCH_TYPES_H
+
+#include <stdatomic.h> // Contadores atómicos
+#include "scheduler_types.h" // Tipos de planificación
+
+// Constantes del modo por épocas
+#define EPOCH_BATCH_HIVES 16 // Colmenas que reclama un trabajador de cada vez
+
+// Época en curso: los trabajadores del pool se reparten las colmenas reclamando lotes consecutivos
+typedef struct {
+    ProcessInfo** processes; // Tabla de procesos
+    int count; // Colmenas que avanzan en la época (las nacidas en ella esperan a la siguiente)
+    atomic_int next; // Primera colmena sin reclamar
+} EpochStep;
+
+#endif
@@ -4,6 +4,7 @@
 #include <time.h> // Biblioteca de tiempo
 #include <stdbool.h> // Biblioteca de tipos de datos
 #include <json-c/json.h> // Biblioteca de JSON
+#include "clock_types.h" // Tipos de reloj
 
 // Constantes de rutas de los archivos
 #define PCB_FILE "data/pcb.json" // Archivo de control de procesos
@@ -20,14 +21,15 @@ typedef enum {
 // Estructura para el bloque de control de procesos
 typedef struct {
    int process_id;               // ID único del proceso/colmena
-   time_t arrival_time;          // Último tiempo de llegada a cola
+   time_t arrival_time;          // Último tiempo de llegada a cola (hora de pared, para el historial)
+   clock_ns_t arrival_clock;     // Momento monótono de llegada
    int iterations;               // Número de veces que ha entrado en ejecución
    double avg_io_wait_time;      // Tiempo promedio en espera de E/S
    double avg_ready_wait_time;   // Tiempo promedio en cola de listos
    ProcessState state;           // Estado actual del proceso
    int total_io_waits;          // Número total de operaciones E/S
-   time_t last_ready_time;       // Último momento que entró en ready
-   time_t last_state_change;     // Último cambio de estado
+   clock_ns_t last_ready_time;   // Último momento que entró en ready
+   clock_ns_t last_state_change; // Último cambio de estado
    double total_io_wait_time;    // Tiempo total en espera de E/S
    double total_ready_wait_time; // Tiempo total en cola de listos
    int current_io_wait_time;     // Tiempo actual de espera de E/S
@@ -0,0 +1,34 @@
+#ifndef HIVE_SLAB_TYPES_H
+#define HIVE_SLAB_TYPES_H
+
+#include <pthread.h> // Biblioteca de hilos
+#include <semaphore.h> // Biblioteca de semáforos
+#include "scheduler_types.h" // Tipos de planificación
+
+// Constantes del asignador de colmenas
+#define HIVE_BLOCK_ALIGN 64 // Alineación de cada bloque y de sus partes (línea de caché)
+#define HIVE_SLAB_BLOCKS 32 // Bloques por slab
+
+// Bloque contiguo con todo lo que necesita una colmena (una sola reserva por colmena)
+typedef struct HiveBlock {
+    _Alignas(HIVE_BLOCK_ALIGN) ProcessInfo process; // Proceso (lo toca el planificador; va primero para recuperar el bloque)
+    _Alignas(HIVE_BLOCK_ALIGN) Beehive hive; // Colmena (la tocan los trabajadores, en su propia línea de caché)
+    _Alignas(HIVE_BLOCK_ALIGN) ProcessControlBlock pcb; // Bloque de control del proceso
+    sem_t shared_resource_sem; // Semáforo de acceso a los recursos del proceso
+    struct HiveBlock* next_free; // Siguiente bloque de la lista libre (NULL si está en uso o es el último)
+} HiveBlock;
+
+// Slab: bloques reservados de una vez (se liberan todos juntos al terminar)
+typedef struct HiveSlab {
+    struct HiveSlab* next; // Siguiente slab reservado
+    HiveBlock blocks[HIVE_SLAB_BLOCKS]; // Bloques del slab
+} HiveSlab;
+
+// Asignador de bloques de colmena con lista libre
+typedef struct {
+    HiveSlab* slabs; // Slabs reservados
+    HiveBlock* free_list; // Bloques libres (los devueltos se reutilizan primero)
+    pthread_mutex_t mutex; // Mutex de la lista libre
+} HiveSlabAllocator;
+
+#endif
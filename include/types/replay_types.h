@@ -0,0 +1,48 @@
+#ifndef REPLAY_TYPES_H
+#define REPLAY_TYPES_H
+
+#include <stdbool.h> // Biblioteca de tipos de datos
+#include "clock_types.h" // Tipos de reloj
+#include "beehive_types.h" // Tipos de colmenas
+#include "scheduler_types.h" // Tipos de planificación
+
+// Fase de la carga grabada: una ráfaga de CPU seguida (o no) de una E/S
+typedef struct {
+    clock_ns_t cpu_ns; // CPU consumida antes de la E/S
+    int io_ms; // Espera de E/S al terminar la ráfaga (-1 en la última fase)
+    int size; // Tamaño de la colmena (abejas + miel) durante la fase
+} ReplayPhase;
+
+// Proceso reconstruido a partir de la traza
+typedef struct {
+    ProcessInfo info; // Proceso simulado (lo ordenan las políticas)
+    Beehive hive; // Colmena mínima: solo se usa su tamaño
+    bool present; // Indica si el proceso aparece en la traza
+    clock_ns_t arrival_ns; // Momento de nacimiento
+    ReplayPhase* phases; // Fases de la carga
+    int phase_count; // Número de fases
+    int phase_capacity; // Capacidad del arreglo de fases
+    int current_phase; // Fase en curso durante la simulación
+    clock_ns_t remaining_ns; // CPU pendiente de la fase en curso
+    ProcessState state; // Estado simulado
+    bool arrived; // Indica si ya nació en la simulación
+    bool finished; // Indica si ya consumió toda su carga
+    clock_ns_t ready_since; // Momento de entrada en la cola de listos
+    clock_ns_t io_done_at; // Momento en que termina su E/S
+    clock_ns_t finished_at; // Momento en que terminó su carga
+    clock_ns_t recorded_run_start; // Inicio de la ejecución en curso al leer la traza (-1 si no se ejecuta)
+    clock_ns_t recorded_ready_since; // Entrada en listos al leer la traza (-1 si no espera)
+} ReplayProcess;
+
+// Medidas de una ejecución (grabada o reproducida)
+typedef struct {
+    double* ready_waits_ms; // Espera en cola de listos de cada despacho
+    int wait_count; // Número de esperas medidas
+    int wait_capacity; // Capacidad del arreglo de esperas
+    int preemptions; // Expulsiones
+    int io_operations; // Operaciones de E/S
+    clock_ns_t makespan_ns; // Tiempo total simulado o grabado
+    double mean_turnaround_ms; // Tiempo medio de nacimiento a fin de la carga
+} ReplayStats;
+
+#endif
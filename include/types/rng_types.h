@@ -0,0 +1,17 @@
+#ifndef RNG_TYPES_H
+#define RNG_TYPES_H
+
+#include <stdint.h> // Tipos enteros de tamaño fijo
+
+// Identificadores de flujo (cada flujo es una secuencia independiente derivada de la semilla maestra)
+#define RNG_STREAM_SCHEDULER 1 // Flujo del planificador (E/S y quantum)
+#define RNG_STREAM_HIVE_BASE 1024 // Primer flujo de colmena (se suma el ID de la colmena)
+#define RNG_STREAM_BROOD_BASE (1ull << 32) // Primer flujo de cría de colmena (se suma el ID de la colmena)
+#define RNG_BULK_SIZE 64 // Valores generados por lote en los bucles calientes
+
+// Estado de un flujo xoshiro256** (no es seguro entre hilos: cada flujo tiene un único dueño)
+typedef struct {
+    uint64_t s[4]; // Estado interno
+} RngStream;
+
+#endif
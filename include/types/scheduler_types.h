@@ -4,75 +4,188 @@
 #include <pthread.h> // Biblioteca de hilos
 #include <semaphore.h> // Biblioteca de semáforos
 #include <stdbool.h> // Biblioteca de tipos de datos
+#include <stdatomic.h> // Biblioteca de operaciones atómicas
 #include <time.h> // Biblioteca de tiempo
+#include "clock_types.h" // Tipos de reloj
 #include "beehive_types.h" // Tipos de colmenas
 #include "file_manager_types.h" // Tipos de gestión de archivos
+#include "thread_pool_types.h" // Tipos del pool de trabajadores
+#include "rng_types.h" // Tipos del generador de números aleatorios
 
 // Constantes de planificación
-#define MIN_QUANTUM 2 // Tiempo mínimo de quantum
-#define MAX_QUANTUM 10 // Tiempo máximo de quantum
-#define QUANTUM_UPDATE_INTERVAL 10 // Intervalo de actualización de quantum
-#define POLICY_SWITCH_THRESHOLD 30 // Límite de cambio de política
-#define MAX_PROCESSES 40 // Número máximo de procesos
+#define MIN_QUANTUM 2000 // Tiempo mínimo de quantum (ms)
+#define MAX_QUANTUM 10000 // Tiempo máximo de quantum (ms)
+#define QUANTUM_UPDATE_INTERVAL 10 // Intervalo de actualización de quantum (s)
+#define POLICY_SWITCH_THRESHOLD 30 // Límite de cambio de política (s)
+#define SCHEDULER_TICK_MS 1000 // Periodo del bucle de planificación (ms)
+#define MAX_PROCESSES 40 // Número máximo de procesos por defecto (se cambia con --max-hives)
+#define PROCESS_LIMIT (1 << 20) // Tope configurable de procesos (la tabla y las colas crecen hasta el máximo elegido)
+#define QUEUE_INITIAL_CAPACITY 16 // Capacidad inicial de las colas de listos y de E/S (se duplica al llenarse)
 #define PROCESS_TIME_SLICE 100 // Límite de tiempo de proceso
+#define MAX_DISPATCH_SLOTS 64 // Número máximo de núcleos de despacho
 
 // Constantes para E/S
 #define IO_PROBABILITY 5 // Probabilidad de E/S
 #define MIN_IO_WAIT 30 // Tiempo mínimo de espera de E/S
 #define MAX_IO_WAIT 50 // Tiempo máximo de espera de E/S
-#define MAX_IO_QUEUE_SIZE 40 // Tamaño máximo de la cola de E/S
+
+// Constantes de las políticas adicionales
+#define MLFQ_LEVELS 3 // Niveles de la cola multinivel con retroalimentación
+#define MLFQ_BASE_QUANTUM 2000 // Quantum del nivel más prioritario (ms), se duplica en cada nivel
+#define MLFQ_BOOST_INTERVAL 20 // Intervalo para devolver un proceso al nivel superior (s)
+#define CFS_MIN_GRANULARITY 2000 // Tiempo mínimo de ejecución antes de ceder el núcleo (ms)
+#define CFS_WAKEUP_GRANULARITY 500 // Ventaja de tiempo virtual necesaria para desplazar al activo (ms)
+#define WFS_REFERENCE_WEIGHT 50 // Peso de referencia (abejas + miel) para el reparto ponderado
+
+// Constantes del controlador adaptativo de quantum
+#define CONTROLLER_SAMPLE_INTERVAL 5 // Duración de cada ventana de medición (s)
+#define CONTROLLER_SMOOTHING 0.5 // Peso de la ventana nueva en las medias móviles
+#define CONTROLLER_TARGET_READY_WAIT 8000 // Espera en cola de listos objetivo por despacho (ms)
+#define CONTROLLER_MAX_SWITCH_RATIO 0.5 // Fracción máxima de ráfagas cortadas por expulsión
+#define CONTROLLER_IO_BOUND_RATIO 0.5 // Fines de E/S por despacho a partir de los que la carga es de E/S
+#define CONTROLLER_GROWTH_FACTOR 1.25 // Crecimiento del quantum cuando hay demasiadas expulsiones
+#define CONTROLLER_MIN_SHRINK_FACTOR 0.5 // Mayor reducción del quantum en una sola ventana
+#define CONTROLLER_SWITCH_MARGIN 1.1 // Ventaja mínima de la otra política para cambiar
 
 // Tipos de políticas de planificación
 typedef enum {
     ROUND_ROBIN, // Round Robin
-    SHORTEST_JOB_FIRST // Shortest Job First
+    SHORTEST_JOB_FIRST, // Shortest Job First
+    MULTILEVEL_FEEDBACK, // Cola multinivel con retroalimentación
+    COMPLETELY_FAIR, // Reparto justo por tiempo virtual (estilo CFS)
+    WEIGHTED_FAIR_SHARE, // Reparto justo ponderado por tamaño de colmena
+    POLICY_COUNT // Número de políticas disponibles
 } SchedulingPolicy;
 
+// Modos de ajuste del quantum y del cambio de política
+typedef enum {
+    QUANTUM_MODE_RANDOM, // Quantum aleatorio y cambio de política periódico
+    QUANTUM_MODE_ADAPTIVE // Quantum y cambio de política guiados por las esperas medidas
+} QuantumMode;
+
 // Información de proceso
 typedef struct ProcessInfo {
     Beehive* hive; // Colmena del proceso
     int index; // Índice del proceso en la colmena
-    pthread_t thread_id; // ID de la thread del proceso
+    atomic_bool tick_pending; // Indica si hay un ciclo de la colmena encolado o en ejecución en el pool
+    _Atomic clock_ns_t dispatched_at; // Momento del último despacho aún no atendido (0 si no hay)
+    pthread_mutex_t park_mutex; // Mutex para estacionar la colmena cuando no tiene ciclo en curso
+    pthread_cond_t park_cond; // Condición que se señala cuando termina el ciclo de la colmena
     sem_t* shared_resource_sem; // Semáforo para el acceso a recursos compartidos
-    time_t last_quantum_start; // Último momento de inicio de quantum
+    clock_ns_t last_quantum_start; // Último momento de inicio de quantum
     ProcessControlBlock* pcb; // Bloque de control del proceso
+    int slot; // Núcleo de despacho del proceso (cola de listos en la que espera)
+    int ready_queue_index; // Posición del proceso en el montículo de listos
+    unsigned long ready_sequence; // Orden de llegada a la cola de listos (desempate FIFO)
+    clock_ns_t last_account_time; // Último momento en que se contabilizó su tiempo de CPU
+    int mlfq_level; // Nivel actual en la cola multinivel
+    clock_ns_t mlfq_level_since; // Momento en que llegó a su nivel actual
+    clock_ns_t vruntime; // Tiempo virtual de ejecución (CFS y reparto ponderado)
+    struct ProcessInfo* handoff_next; // Enlace intrusivo en la pila de traspaso hacia la cola de listos
 } ProcessInfo;
 
+// Pila de traspaso sin bloqueo (varios productores, un consumidor) hacia las colas de listos
+typedef struct {
+    _Atomic(ProcessInfo*) head; // Último proceso publicado (NULL si está vacía)
+    atomic_int pending; // Procesos publicados y aún no drenados
+} ReadyHandoff;
+
 // Entrada en la cola de E/S
 typedef struct {
     ProcessInfo* process; // Proceso asociado a la entrada
     int wait_time; // Tiempo de espera
-    time_t start_time; // Tiempo de inicio de la entrada
+    clock_ns_t start_time; // Tiempo de inicio de la entrada
+    clock_ns_t deadline; // Momento en que termina la E/S
 } IOQueueEntry;
 
-// Cola de E/S
+// Cola de E/S (montículo mínimo ordenado por fecha límite)
 typedef struct {
-    IOQueueEntry entries[MAX_IO_QUEUE_SIZE]; // Entradas de la cola
+    IOQueueEntry* entries; // Entradas de la cola (la cima es la próxima E/S en completarse)
     int size; // Tamaño de la cola
+    int capacity; // Entradas reservadas
+    int limit; // Máximo de entradas (tope de procesos)
     pthread_mutex_t mutex; // Mutex para el acceso a la cola
-    pthread_cond_t condition; // Condición para espera de E/S
+    pthread_cond_t condition; // Condición para espera de E/S (usa CLOCK_MONOTONIC)
 } IOQueue;
 
-// Cola de procesos listos
+// Cola de procesos listos (montículo binario indexado)
 typedef struct {
-    ProcessInfo* processes[MAX_PROCESSES]; // Procesos listos
-    int size; // Tamaño de la cola
+    ProcessInfo** processes; // Montículo de procesos listos (la cima es el siguiente en ejecutarse)
+    atomic_int size; // Tamaño de la cola (se escribe con el mutex; los demás núcleos lo leen sin él)
+    int capacity; // Huecos reservados
+    int limit; // Máximo de procesos (tope de procesos)
+    unsigned long next_sequence; // Siguiente número de llegada (orden FIFO para Round Robin)
+    clock_ns_t min_vruntime; // Menor tiempo virtual despachado desde esta cola (base para los que llegan)
     pthread_mutex_t mutex; // Mutex para el acceso a la cola
 } ReadyQueue;
 
+// Núcleo de despacho: ejecuta una colmena a la vez con su propia cola de listos
+typedef struct {
+    int id; // Número del núcleo
+    ProcessInfo* active_process; // Proceso activo en el núcleo
+    ReadyQueue* ready_queue; // Cola local de procesos listos
+} DispatchSlot;
+
+// Operaciones de una política de planificación (la cima del montículo es su pick_next)
+typedef struct {
+    SchedulingPolicy id; // Identificador de la política
+    const char* name; // Nombre legible
+    const char* short_name; // Nombre corto (para la línea de órdenes)
+    bool uses_quantum; // Indica si la política usa el quantum aleatorio
+    bool (*precedes)(const ProcessInfo* a, const ProcessInfo* b); // Orden de la cola de listos: a se ejecuta antes que b
+    void (*enqueue)(ReadyQueue* queue, ProcessInfo* process, clock_ns_t now); // Ajusta el proceso al entrar en la cola de listos
+    bool (*tick)(ProcessInfo* current, clock_ns_t ran_ns, clock_ns_t slice_ns, const ProcessInfo* next); // Contabiliza CPU desde last_account_time; true si el activo debe ceder el núcleo
+    bool (*preempt_check)(const ProcessInfo* candidate, const ProcessInfo* current); // true si el candidato debe desplazar al activo
+    bool (*age)(ProcessInfo* queued, clock_ns_t now); // Envejece un proceso que espera en la cola; true si cambió su prioridad
+} SchedulerPolicyOps;
+
+// Controlador adaptativo: acumula una ventana de medidas de los PCB y mantiene medias móviles
+typedef struct {
+    QuantumMode mode; // Modo de ajuste
+    clock_ns_t window_start; // Inicio de la ventana de medición actual
+    atomic_llong window_ready_wait_ns; // Espera en cola de listos acumulada en la ventana
+    atomic_llong window_io_wait_ns; // Espera de E/S acumulada en la ventana
+    atomic_int window_dispatches; // Despachos (READY → RUNNING) en la ventana
+    atomic_int window_bursts; // Ráfagas de CPU terminadas (salidas de RUNNING) en la ventana
+    atomic_int window_preemptions; // Ráfagas cortadas por la política (RUNNING → READY) en la ventana
+    atomic_int window_io_completions; // Fines de E/S (WAITING → READY) en la ventana
+    bool has_samples; // Indica si ya se cerró alguna ventana con despachos
+    double ready_wait_ms; // Media móvil de la espera en cola de listos por despacho (ms)
+    double io_wait_ms; // Media móvil de la espera de E/S por operación (ms)
+    double switch_ratio; // Media móvil de la fracción de ráfagas cortadas por expulsión
+    double io_ratio; // Media móvil de fines de E/S por despacho
+    double context_switch_rate; // Media móvil de despachos por segundo
+    double policy_ready_wait_ms[POLICY_COUNT]; // Media móvil de la espera por política
+    bool policy_measured[POLICY_COUNT]; // Indica si la política ya tiene medidas
+} QuantumController;
+
 // Estado del planificador
 typedef struct {
     SchedulingPolicy current_policy; // Política actual
-    int current_quantum; // Quantum actual
-    time_t last_quantum_update; // Último momento de actualización de quantum
-    time_t last_policy_switch; // Último momento de cambio de política
+    const SchedulerPolicyOps* policy; // Operaciones de la política actual
+    bool auto_switch_policy; // Indica si se alterna de política cada POLICY_SWITCH_THRESHOLD segundos
+    int current_quantum; // Quantum actual (ms)
+    clock_ns_t last_quantum_update; // Último momento de actualización de quantum
+    clock_ns_t last_policy_switch; // Último momento de cambio de política
     bool running; // Indica si el planificador está en ejecución
     pthread_t policy_control_thread; // Thread para control de política
     pthread_t io_thread; // Thread para E/S
+    ThreadPool worker_pool; // Pool de trabajadores que ejecuta los ciclos de las colmenas
+    QuantumController controller; // Controlador del quantum y del cambio de política
+    RngStream rng; // Flujo aleatorio del planificador (solo lo usa el hilo de control de política)
+    ReadyHandoff ready_handoff; // Fin de E/S y colmenas nuevas pendientes de entrar en las colas de listos
+    atomic_llong dispatch_latency_total_ns; // Suma de latencias despacho → inicio de ciclo
+    atomic_llong dispatch_latency_max_ns; // Mayor latencia de despacho observada
+    atomic_int dispatch_count; // Número de despachos medidos
+    atomic_int preemption_count; // Número de expulsiones (RUNNING → READY)
+    int process_limit; // Máximo de procesos (tope de la tabla y de las colas)
+    atomic_int ready_overflows; // Procesos que no cupieron en una cola de listos
+    atomic_int io_overflows; // Peticiones de E/S que no cupieron en la cola de E/S (el proceso vuelve a listos)
+    atomic_int spawn_overflows; // Colmenas nuevas descartadas por alcanzar el máximo de procesos
     sem_t scheduler_sem; // Semáforo para el acceso al planificador
-    ProcessInfo* active_process; // Proceso activo
+    DispatchSlot slots[MAX_DISPATCH_SLOTS]; // Núcleos de despacho
+    int slot_count; // Número de núcleos de despacho en uso
     IOQueue* io_queue; // Cola de E/S
-    ReadyQueue* ready_queue; // Cola de procesos listos
     ProcessTable* process_table; // Tabla de control de procesos
     pthread_mutex_t scheduler_mutex; // Mutex para el acceso al planificador
 } SchedulerState;
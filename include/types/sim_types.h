@@ -0,0 +1,31 @@
+#ifndef SIM_TYPES_H
+#define SIM_TYPES_H
+
+#include <pthread.h> // Biblioteca de hilos
+#include "clock_types.h" // Tipos de reloj
+
+// Constantes de la cola de eventos
+#define SIM_INITIAL_EVENTS 64 // Capacidad inicial de la cola de eventos
+
+// Acción de un evento (se ejecuta en el hilo que conduce la simulación)
+typedef void (*SimEventFn)(void* arg);
+
+// Evento de la simulación en tiempo virtual
+typedef struct {
+    clock_ns_t time; // Momento del evento
+    unsigned long sequence; // Orden de inserción (desempate entre eventos simultáneos)
+    clock_ns_t period; // Periodo para eventos repetitivos (0 si es único)
+    SimEventFn fn; // Acción del evento
+    void* arg; // Argumento de la acción
+} SimEvent;
+
+// Cola global de eventos (montículo mínimo por momento)
+typedef struct {
+    SimEvent* events; // Montículo de eventos (la cima es el próximo)
+    int size; // Número de eventos
+    int capacity; // Capacidad del arreglo
+    unsigned long next_sequence; // Siguiente número de inserción
+    pthread_mutex_t mutex; // Mutex para el acceso a la cola
+} SimEventQueue;
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef THREAD_POOL_TYPES_H
+#define THREAD_POOL_TYPES_H
+
+#include <pthread.h> // Biblioteca de hilos
+#include <stdbool.h> // Biblioteca de tipos de datos
+
+// Constantes del pool de trabajadores
+#define THREAD_POOL_INITIAL_CAPACITY 64 // Capacidad inicial de la cola de tareas
+#define MAX_POOL_WORKERS 64 // Número máximo de hilos trabajadores
+
+// Función que ejecuta una tarea
+typedef void (*ThreadPoolTaskFn)(void* arg);
+
+// Tarea pendiente
+typedef struct {
+    ThreadPoolTaskFn function; // Función a ejecutar
+    void* arg; // Argumento de la función
+} ThreadPoolTask;
+
+// Pool de hilos trabajadores de tamaño fijo
+typedef struct {
+    pthread_t workers[MAX_POOL_WORKERS]; // Hilos trabajadores
+    int worker_count; // Número de hilos trabajadores
+    ThreadPoolTask* tasks; // Cola circular de tareas
+    int capacity; // Capacidad de la cola de tareas
+    int head; // Posición de la próxima tarea a ejecutar
+    int size; // Número de tareas pendientes
+    int active; // Número de tareas en ejecución
+    bool shutting_down; // Indica si el pool se está cerrando
+    pthread_mutex_t mutex; // Mutex para el acceso a la cola de tareas
+    pthread_cond_t task_available; // Condición para despertar trabajadores
+    pthread_cond_t idle; // Condición para esperar a que el pool quede ocioso
+} ThreadPool;
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef TRACE_TYPES_H
+#define TRACE_TYPES_H
+
+#include <stdint.h> // Tipos enteros de tamaño fijo
+#include "clock_types.h" // Tipos de reloj
+
+// Constantes de la traza binaria
+#define TRACE_FILE "data/scheduler_trace.bin" // Archivo de traza del planificador
+#define TRACE_MAGIC 0x52544842u // Firma del archivo ("BHTR")
+#define TRACE_VERSION 1 // Versión del formato
+#define TRACE_BUFFER_RECORDS 256 // Registros acumulados antes de escribir en disco
+#define TRACE_NO_PROCESS -1 // Registro que no pertenece a ningún proceso
+
+// Tipos de evento de la traza
+typedef enum {
+    TRACE_DISPATCH = 1, // Un proceso entra en ejecución (READY → RUNNING)
+    TRACE_PREEMPT, // Un proceso sale de ejecución sin pedir E/S (RUNNING → READY)
+    TRACE_IO_START, // Un proceso entra en la cola de E/S (value: espera en ms)
+    TRACE_IO_END, // Un proceso completa su E/S (WAITING → READY)
+    TRACE_SPAWN, // Nace una colmena
+    TRACE_QUANTUM, // Cambia el quantum (value: quantum en ms)
+    TRACE_POLICY // Cambia la política (value: SchedulingPolicy)
+} TraceEventType;
+
+// Cabecera del archivo de traza
+typedef struct {
+    uint32_t magic; // Firma del archivo
+    uint16_t version; // Versión del formato
+    uint16_t record_size; // Tamaño de cada registro en bytes
+    int32_t slot_count; // Núcleos de despacho de la ejecución grabada
+    int32_t reserved; // Reservado (alineación)
+} TraceHeader;
+
+// Registro de la traza (tamaño fijo, 24 bytes)
+typedef struct {
+    int64_t time_ns; // Momento del evento desde el inicio de la traza
+    int32_t process; // Índice del proceso (TRACE_NO_PROCESS si no aplica)
+    int32_t value; // Dato del evento (espera de E/S, quantum o política)
+    int32_t size; // Tamaño de la colmena (abejas + miel) en el momento del evento
+    uint16_t slot; // Núcleo de despacho del proceso
+    uint8_t type; // Tipo de evento (TraceEventType)
+    uint8_t reserved; // Reservado (alineación)
+} TraceRecord;
+
+#endif
@@ -6,62 +6,113 @@
 #include "../include/core/utils.h" // Utilidades
 #include "../include/core/file_manager.h" // Gestión de archivos
 #include "../include/core/scheduler.h" // Planificador
+#include "../include/core/clock.h" // Reloj monótono
+#include "../include/core/thread_pool.h" // Pool de trabajadores
+#include "../include/core/hive_slab.h" // Asignador de colmenas
+#include "../include/core/rng.h" // Generador de números aleatorios
+#include "../include/core/cell_mask.h" // Mapas de bits de las celdas
+#include "../include/core/polen_kernel.h" // Núcleo vectorial de recolección de polen
+
+static inline BeeSet bee_range(int count) {// Conjunto de las abejas 0..count-1
+    return count >= 64 ? ~(BeeSet)0 : ((BeeSet)1 << count) - 1;// Bits bajos encendidos
+}
+
+BeeHandle bee_handle(const BeeColony* bees, int slot) {// Referencia a la abeja que ocupa un hueco
+    return ((BeeHandle)bees->generation[slot] << BEE_HANDLE_SLOT_BITS) | (BeeHandle)slot;// Generación e índice
+}
+
+int bee_slot(const BeeColony* bees, BeeHandle handle) {// Hueco de una abeja (-1 si murió o la referencia es antigua)
+    if (handle == BEE_HANDLE_NONE) return -1;// Sin abeja
+    int slot = handle & ((1u << BEE_HANDLE_SLOT_BITS) - 1);// Índice del hueco
+    if (slot >= MAX_BEES || !((bees->alive >> slot) & 1)) return -1;// Hueco libre
+    return bees->generation[slot] == (uint16_t)(handle >> BEE_HANDLE_SLOT_BITS) ? slot : -1;// La generación debe coincidir
+}
 
 bool is_egg_position(int i, int j) {
-    if (i >= 2 && i <= 7) { // Filas 3-8
-        if (i == 4 || i == 5) { // Filas 5-6
-            return (j >= 1 && j <= 8); // Todo excepto primera y última columna
-        } else {
-            return (j >= 2 && j <= 7); // Columnas 3-8
-        }
-    }
-    return false;
+    return cell_mask_test(&EGG_ZONE, cell_index(i, j));// Zona de huevos de la geometría elegida al compilar
 }
 
 bool find_empty_cell_for_egg(Chamber* chamber, int* x, int* y) {
-    for (int i = 0; i < MAX_CHAMBER_SIZE; i++) {// Recorrer todas las filas
-        for (int j = 0; j < MAX_CHAMBER_SIZE; j++) {// Recorrer todas las columnas
-            if (is_egg_position(i, j) && !chamber->cells[i][j].has_egg) {// Comprobar si la posición está vacía y no tiene huevo
-                *x = i;// Guardar la posición
-                *y = j;// Guardar la posición
-                return true;// Retornar que se encontró una posición vacía
-            }
-        }
-    }
-    return false;// Retornar que no se encontró una posición vacía
+    int index = cell_mask_first_free(&chamber->egg_mask, &EGG_ZONE);// Menor celda de la zona de huevos sin huevo
+    if (index < 0) return false;// Retornar que no se encontró una posición vacía
+    *x = index / MAX_CHAMBER_SIZE;// Guardar la posición
+    *y = index % MAX_CHAMBER_SIZE;// Guardar la posición
+    return true;// Retornar que se encontró una posición vacía
 }
 
 bool find_empty_cell_for_honey(Chamber* chamber, int* x, int* y) {
-    for (int i = 0; i < MAX_CHAMBER_SIZE; i++) {// Recorrer todas las filas
-        for (int j = 0; j < MAX_CHAMBER_SIZE; j++) {// Recorrer todas las columnas
-            if (!is_egg_position(i, j) && !chamber->cells[i][j].has_honey) {// Comprobar si la posición está vacía y no tiene miel
-                *x = i;// Guardar la posición
-                *y = j;// Guardar la posición
-                return true;// Retornar que se encontró una posición vacía
-            }
+    int index = cell_mask_first_free(&chamber->honey_mask, &HONEY_ZONE);// Menor celda de la zona de miel sin miel
+    if (index < 0) return false;// Retornar que no se encontró una posición vacía
+    *x = index / MAX_CHAMBER_SIZE;// Guardar la posición
+    *y = index % MAX_CHAMBER_SIZE;// Guardar la posición
+    return true;// Retornar que se encontró una posición vacía
+}
+
+void refresh_chamber_space(Beehive* hive, int c) {// Actualizar el índice de cámaras con sitio tras llenar o vaciar una cámara (con su mutex retenido)
+    ChamberSet bit = (ChamberSet)1 << c;// Bit de la cámara
+    Chamber* chamber = &hive->chambers[c];// Cámara actualizada
+    if (chamber->egg_count < MAX_EGGS_PER_CHAMBER) atomic_fetch_or(&hive->egg_space, bit);// Admite más huevos
+    else atomic_fetch_and(&hive->egg_space, ~bit);// Llena de huevos
+    if (chamber->honey_count < MAX_HONEY_PER_CHAMBER) atomic_fetch_or(&hive->honey_space, bit);// Admite más miel
+    else atomic_fetch_and(&hive->honey_space, ~bit);// Llena de miel
+}
+
+static inline EggCell* egg_cell(Beehive* hive, uint16_t egg) {// Datos de eclosión de un huevo (cámara * CHAMBER_CELLS + celda)
+    return &hive->chambers[egg / CHAMBER_CELLS].eggs[egg_cell_slot(egg % CHAMBER_CELLS)];// Entrada compacta de la celda
+}
+
+void init_hatch_wheel(HatchWheel* wheel, clock_ns_t now) {// Vaciar la rueda de eclosión
+    for (int i = 0; i < HATCH_WHEEL_SLOTS; i++) {// Recorrer las ranuras
+        wheel->head[i] = HATCH_NONE;// Ranura vacía
+        wheel->tail[i] = HATCH_NONE;// Ranura vacía
+    }
+    wheel->cursor = (uint64_t)now / HATCH_WHEEL_GRANULARITY_NS;// Nada pendiente antes de ahora
+    wheel->base = wheel->cursor;// Las ranuras relativas parten de ahora
+}
+
+static void rebase_hatch_wheel(Beehive* hive, uint64_t base) {// Adelantar la base de la rueda y reescribir las ranuras relativas pendientes
+    HatchWheel* wheel = &hive->hatch_wheel;// Rueda de la colmena
+    uint64_t shift = base - wheel->base;// Ranuras que se adelanta la base
+    for (int slot = 0; slot < HATCH_WHEEL_SLOTS; slot++) {// Recorrer las ranuras
+        for (uint16_t egg = wheel->head[slot]; egg != HATCH_NONE; egg = egg_cell(hive, egg)->hatch_next) {// Recorrer los huevos pendientes
+            EggCell* cell = egg_cell(hive, egg);// Datos de eclosión del huevo
+            cell->hatch_tick = cell->hatch_tick > shift ? (uint16_t)(cell->hatch_tick - shift) : 0;// Los que vencían antes de la nueva base quedan vencidos
         }
     }
-    return false;// Retornar que no se encontró una posición vacía
+    wheel->base = base;// Nueva base
+}
+
+void schedule_egg_hatch(Beehive* hive, int c, int index, clock_ns_t lay_time) {// Encolar un huevo recién puesto en la ranura de su eclosión (con hatch_mutex retenido)
+    HatchWheel* wheel = &hive->hatch_wheel;// Rueda de la colmena
+    clock_ns_t deadline = lay_time + MAX_EGG_HATCH_TIME * CLOCK_NS_PER_MS;// Momento de eclosión
+    uint64_t tick = ((uint64_t)deadline + HATCH_WHEEL_GRANULARITY_NS - 1) / HATCH_WHEEL_GRANULARITY_NS;// Ranura absoluta redondeada hacia arriba: al revisarla el huevo ya venció
+    int slot = (int)(tick & (HATCH_WHEEL_SLOTS - 1));// Ranura en la rueda
+    uint16_t egg = (uint16_t)(c * CHAMBER_CELLS + index);// Identificador del huevo
+
+    if (tick > wheel->base + UINT16_MAX) rebase_hatch_wheel(hive, tick - HATCH_WHEEL_SLOTS);// La ranura relativa no cabría en 16 bits (ocurre una vez cada ~65 s de simulación)
+    EggCell* cell = egg_cell(hive, egg);// Datos de eclosión del huevo
+    cell->hatch_tick = tick > wheel->base ? (uint16_t)(tick - wheel->base) : 0;// Ranura relativa (0 si ya vencía antes de la base)
+    cell->hatch_next = HATCH_NONE;// Será el último de la ranura
+    if (wheel->tail[slot] == HATCH_NONE) {// Ranura vacía
+        wheel->head[slot] = egg;// Primer huevo
+    } else {// Ranura con huevos
+        egg_cell(hive, wheel->tail[slot])->hatch_next = egg;// Enlazar detrás del último
+    }
+    wheel->tail[slot] = egg;// Nuevo último
 }
 
 void init_chambers(ProcessInfo* process_info) {
     Beehive* hive = process_info->hive;// Obtener la colmena (para acceder a los recursos)
-    time_t current_time = time(NULL);// Obtener la hora actual (para calcular la hora de recolección de polen)
+    clock_ns_t current_time = clock_now_ns();// Obtener la hora actual (para calcular la hora de recolección de polen)
 
     for (int c = 0; c < NUM_CHAMBERS; c++) {// Recorrer todas las cámaras
         Chamber* chamber = &hive->chambers[c];// Obtener la cámara actual (para inicializar las celdas)
-        memset(chamber, 0, sizeof(Chamber));// Inicializar la cámara
-        
-        // Inicializar todas las celdas
-        for (int i = 0; i < MAX_CHAMBER_SIZE; i++) {// Recorrer todas las filas
-            for (int j = 0; j < MAX_CHAMBER_SIZE; j++) {// Recorrer todas las columnas
-                chamber->cells[i][j].has_honey = false;// Inicializar la celda como vacía
-                chamber->cells[i][j].has_egg = false;// Inicializar la celda como vacía
-                chamber->cells[i][j].egg_lay_time = current_time;// Guardar la hora de la última puesta de huevos
-            }
-        }
+        memset(chamber, 0, sizeof(Chamber));// Inicializar la cámara (mapas de huevos y miel vacíos)
+        pthread_mutex_init(&chamber->mutex, NULL);// Inicializar el mutex de la cámara
     }
 
+    init_hatch_wheel(&hive->hatch_wheel, current_time);// Sin huevos pendientes
+
     // Distribuir recursos iniciales
     int honey_remaining = hive->honey_count;// Obtener la cantidad de miel restante
     int eggs_remaining = hive->egg_count;// Obtener la cantidad de huevos restante
@@ -69,30 +120,27 @@ void init_chambers(ProcessInfo* process_info) {
     for (int c = 0; c < NUM_CHAMBERS && (honey_remaining > 0 || eggs_remaining > 0); c++) {// Recorrer todas las cámaras
         Chamber* chamber = &hive->chambers[c];// Obtener la cámara actual (para calcular la posición vacía)
         
-        // Distribuir huevos
-        while (eggs_remaining > 0 && chamber->egg_count < MAX_EGGS_PER_CHAMBER) {// Mientras haya huevos restantes y la cámara no esté llena
-            int x, y;// Posición vacía
-            if (find_empty_cell_for_egg(chamber, &x, &y)) {// Comprobar si hay una posición vacía
-                chamber->cells[x][y].has_egg = true;// Marcar la celda como conteniendo huevo
-                chamber->cells[x][y].egg_lay_time = current_time;// Guardar la hora de la última puesta de huevos
-                chamber->egg_count++;// Incrementar el número de huevos
-                eggs_remaining--;// Restar el número de huevos
-            } else {// Si no hay posición vacía
-                break;// Salir del bucle
-            }
+        // Distribuir huevos (la hora de puesta ya es la actual)
+        int eggs = eggs_remaining < MAX_EGGS_PER_CHAMBER - chamber->egg_count ? eggs_remaining : MAX_EGGS_PER_CHAMBER - chamber->egg_count;// Huevos que caben en la cámara
+        CellMask laid;// Celdas ocupadas
+        eggs = cell_mask_fill(&chamber->egg_mask, &EGG_ZONE, eggs, &laid);// Ocupar las celdas en bloque
+        for (int index = cell_mask_pop(&laid); index >= 0; index = cell_mask_pop(&laid)) {// Recorrer los huevos iniciales
+            schedule_egg_hatch(hive, c, index, current_time);// Encolar su eclosión
         }
+        chamber->egg_count += eggs;// Incrementar el número de huevos
+        eggs_remaining -= eggs;// Restar el número de huevos
 
         // Distribuir miel
-        while (honey_remaining > 0 && chamber->honey_count < MAX_HONEY_PER_CHAMBER) {// Mientras haya miel restantes y la cámara no esté llena
-            int x, y;// Posición vacía
-            if (find_empty_cell_for_honey(chamber, &x, &y)) {// Comprobar si hay una posición vacía
-                chamber->cells[x][y].has_honey = true;// Marcar la celda como conteniendo miel
-                chamber->honey_count++;// Incrementar el número de miel
-                honey_remaining--;// Restar el número de miel
-            } else {// Si no hay posición vacía
-                break;// Salir del bucle
-            }
-        }
+        int honey = honey_remaining < MAX_HONEY_PER_CHAMBER - chamber->honey_count ? honey_remaining : MAX_HONEY_PER_CHAMBER - chamber->honey_count;// Miel que cabe en la cámara
+        honey = cell_mask_fill(&chamber->honey_mask, &HONEY_ZONE, honey, NULL);// Ocupar las celdas en bloque
+        chamber->honey_count += honey;// Incrementar el número de miel
+        honey_remaining -= honey;// Restar el número de miel
+    }
+
+    hive->egg_space = 0;// Reconstruir el índice de cámaras con sitio
+    hive->honey_space = 0;// Reconstruir el índice de cámaras con sitio
+    for (int c = 0; c < NUM_CHAMBERS; c++) {// Recorrer todas las cámaras
+        refresh_chamber_space(hive, c);// Marcar si la cámara admite huevos o miel
     }
 }
 
@@ -100,16 +148,42 @@ void update_bees_and_honey_count(Beehive* hive) {// Actualizar el contador de ab
     hive->bees_and_honey_count = hive->bee_count + hive->honey_count;// Actualizar el contador
 }
 
+void add_hive_honey(Beehive* hive, int amount) {// Sumar miel a la colmena manteniendo la clave de FSJ
+    atomic_fetch_add(&hive->honey_count, amount);// Actualizar la miel
+    atomic_fetch_add(&hive->bees_and_honey_count, amount);// Sumar la diferencia (no se recalcula: las abejas pueden cambiar a la vez)
+}
+
+void count_bee_birth(Beehive* hive, BeeType type) {// Registrar un nacimiento en los agregados (con bees_mutex retenido)
+    hive->bee_count++;// Incrementar el número de abejas
+    if (type == QUEEN) hive->aggregates.queens++;// Una reina más
+    else hive->aggregates.alive_workers++;// Una obrera más
+    atomic_fetch_add(&hive->bees_and_honey_count, 1);// Actualizar el contador de abejas + miel
+}
+
+void count_bee_death(Beehive* hive, BeeType type) {// Registrar una muerte en los agregados (con bees_mutex retenido)
+    hive->bee_count--;// Restar el número de abejas
+    hive->dead_bees++;// Incrementar el número de abejas muertas
+    if (type == QUEEN) {// Reina
+        hive->aggregates.queens--;// Una reina menos
+    } else {// Obrera
+        hive->aggregates.alive_workers--;// Una obrera viva menos
+        hive->aggregates.dead_workers++;// Una obrera muerta más
+    }
+    atomic_fetch_sub(&hive->bees_and_honey_count, 1);// Actualizar el contador de abejas + miel
+}
+
 void init_beehive_process(ProcessInfo* process_info, int id) {// Inicializar el proceso de la apicultura de abejas
     // Asignar e inicializar la colmena
-    process_info->hive = malloc(sizeof(Beehive));// Crear un objeto de la colmena
+    process_info->hive = hive_slab_hive(process_info);// La colmena vive en el bloque del proceso
     Beehive* hive = process_info->hive;// Obtener el objeto de la colmena
 
     // Inicializar datos básicos
     hive->id = id;// Asignar el ID de la colmena
-    hive->bee_count = random_range(MIN_BEES, MAX_BEES);// Generar el número de abejas
-    hive->honey_count = random_range(MIN_HONEY, MAX_HONEY);// Generar el número de miel
-    hive->egg_count = random_range(MIN_EGGS, MAX_EGGS);// Generar el número de huevos
+    rng_stream_init(&hive->rng, RNG_STREAM_HIVE_BASE + id);// Flujo aleatorio propio de la colmena (reproducible con la semilla maestra)
+    rng_stream_init(&hive->brood_rng, RNG_STREAM_BROOD_BASE + id);// Flujo de la cría (independiente del orden de las demás tareas)
+    hive->bee_count = rng_range(&hive->rng, MIN_BEES, MAX_BEES);// Generar el número de abejas
+    hive->honey_count = rng_range(&hive->rng, MIN_HONEY, MAX_HONEY);// Generar el número de miel
+    hive->egg_count = rng_range(&hive->rng, MIN_EGGS, MAX_EGGS);// Generar el número de huevos
     hive->hatched_eggs = 0;// Inicializar el número de huevos eclosionados
     hive->dead_bees = 0;// Inicializar el número de abejas muertas
     hive->born_bees = 0;// Inicializar el número de abejas nacidas
@@ -120,9 +194,9 @@ void init_beehive_process(ProcessInfo* process_info, int id) {// Inicializar el
     // Actualizar contador de abejas + miel
     update_bees_and_honey_count(hive);// Actualizar el contador de abejas + miel
 
-    // Inicializar mutexes
-    pthread_mutex_init(&hive->chamber_mutex, NULL);// Inicializar el mutex de la cámara
-    pthread_mutex_init(&hive->resources.polen_mutex, NULL);// Inicializar el mutex de polen
+    // Inicializar mutexes (los de las cámaras se inicializan con ellas)
+    pthread_mutex_init(&hive->bees_mutex, NULL);// Inicializar el mutex de las abejas
+    pthread_mutex_init(&hive->hatch_mutex, NULL);// Inicializar el mutex de la rueda de eclosión
 
     // Inicializar recursos
     hive->resources.total_polen = 0;// Inicializar el total de polen
@@ -130,18 +204,18 @@ void init_beehive_process(ProcessInfo* process_info, int id) {// Inicializar el
     hive->resources.total_polen_collected = 0;// Inicializar el total de polen recolectado
 
     // Inicializar abejas
-    hive->bees = malloc(sizeof(Bee) * hive->bee_count);// Crear un arreglo de abejas
-    int queen_index = random_range(0, hive->bee_count - 1);// Obtener la posición de la reina (para asignar el tipo de la abeja)
-    time_t current_time = time(NULL);// Obtener la hora actual (para calcular la hora de recolección de polen)
-
+    BeeColony* bees = &hive->bees;// Abejas de la colmena
+    memset(bees, 0, sizeof(BeeColony));// Todos los carriles a cero (los libres no suman polen)
+    int queen_index = rng_range(&hive->rng, 0, hive->bee_count - 1);// Obtener la posición de la reina (para asignar el tipo de la abeja)
+    bees->alive = bee_range(hive->bee_count);// Todas nacen vivas
+    bees->workers = bees->alive & ~((BeeSet)1 << queen_index);// Todas obreras salvo la reina
+    bees->last_collection_time = clock_now_ns();// Guardar la hora de la última recolección de polen
     for (int i = 0; i < hive->bee_count; i++) {// Recorrer todas las abejas
-        hive->bees[i].id = i;// Asignar el ID de la abeja
-        hive->bees[i].type = (i == queen_index) ? QUEEN : WORKER;// Asignar el tipo de la abeja (reina o obrera)
-        hive->bees[i].polen_collected = 0;// Inicializar el polen recolectado
-        hive->bees[i].is_alive = true;// Inicializar la vida de la abeja
-        hive->bees[i].last_collection_time = current_time;// Guardar la hora de la última recolección de polen
-        hive->bees[i].last_egg_laying_time = current_time;// Guardar la hora de la última puesta de huevos
+        bees->polen_lifetime[i] = rng_range(&hive->rng, MIN_POLEN_LIFETIME, MAX_POLEN_LIFETIME);// Sortear su límite de vida
     }
+    hive->aggregates.queens = 1;// Una reina inicial
+    hive->aggregates.alive_workers = hive->bee_count - 1;// El resto son obreras
+    hive->aggregates.dead_workers = 0;// Sin muertes todavía
 
     // Inicializar cámaras
     init_chambers(process_info);// Inicializar las cámaras
@@ -149,8 +223,8 @@ void init_beehive_process(ProcessInfo* process_info, int id) {// Inicializar el
     // Inicializar semáforos del proceso
     init_process_semaphores(process_info);// Inicializar los semáforos del proceso
 
-    // Asignar memoria e inicializar el PCB
-    process_info->pcb = malloc(sizeof(ProcessControlBlock));// Crear un objeto del PCB
+    // Inicializar el PCB (también en el bloque del proceso)
+    process_info->pcb = hive_slab_pcb(process_info);// PCB del bloque
 
     // Crear entrada PCB en el archivo
     create_pcb_for_beehive(process_info);// Crear la entrada del PCB en el archivo
@@ -158,10 +232,10 @@ void init_beehive_process(ProcessInfo* process_info, int id) {// Inicializar el
     // Iniciar el proceso
     start_process_thread(process_info);// Iniciar el hilo del proceso
 
-    printf("\nColmena #%d creada exitosamente:\n", id);// Imprimir el mensaje de creación de colmena
-    printf("├─ Población inicial: %d abejas\n", hive->bee_count);// Imprimir la población inicial
-    printf("├─ Reservas de miel: %d unidades\n", hive->honey_count);// Imprimir las reservas de miel
-    printf("└─ Huevos iniciales: %d\n", hive->egg_count);// Imprimir los huevos iniciales
+    log_printf("\nColmena #%d creada exitosamente:\n", id);// Imprimir el mensaje de creación de colmena
+    log_printf("├─ Población inicial: %d abejas\n", hive->bee_count);// Imprimir la población inicial
+    log_printf("├─ Reservas de miel: %d unidades\n", hive->honey_count);// Imprimir las reservas de miel
+    log_printf("└─ Huevos iniciales: %d\n", hive->egg_count);// Imprimir los huevos iniciales
 }
 
 void cleanup_beehive_process(ProcessInfo* process_info) {// Limpiar el proceso de la apicultura de abejas
@@ -171,40 +245,69 @@ void cleanup_beehive_process(ProcessInfo* process_info) {// Limpiar el proceso d
 
     // Detener el hilo
     stop_process_thread(process_info);// Detener el hilo del proceso
+    pthread_mutex_destroy(&process_info->park_mutex);// Liberar el mutex de estacionamiento
+    pthread_cond_destroy(&process_info->park_cond);// Liberar la condición de estacionamiento
     
     // Liberar recursos
-    free(hive->bees);// Liberar los arreglos de abejas
-    pthread_mutex_destroy(&hive->chamber_mutex);// Liberar el mutex de las cámaras
-    pthread_mutex_destroy(&hive->resources.polen_mutex);// Liberar el mutex de los recursos
-    
-    // Liberar PCB
-    free(process_info->pcb);// Liberar el PCB
-    process_info->pcb = NULL;// Liberar la memoria
+    for (int c = 0; c < NUM_CHAMBERS; c++) {// Recorrer todas las cámaras
+        pthread_mutex_destroy(&hive->chambers[c].mutex);// Liberar el mutex de la cámara
+    }
+    pthread_mutex_destroy(&hive->bees_mutex);// Liberar el mutex de las abejas
+    pthread_mutex_destroy(&hive->hatch_mutex);// Liberar el mutex de la rueda de eclosión
     
-    // Liberar la colmena
-    free(hive);// Liberar la colmena
-    process_info->hive = NULL;// Liberar la memoria de la colmena en el PCB
+    // El PCB y la colmena se devuelven con el bloque del proceso
+    process_info->pcb = NULL;// Sin PCB
+    process_info->hive = NULL;// Sin colmena
 }
 
-void start_process_thread(ProcessInfo* process_info) {// Iniciar el hilo del proceso principal
+void start_process_thread(ProcessInfo* process_info) {// Dejar el proceso listo para recibir ciclos del pool
+    atomic_store(&process_info->tick_pending, false);// Sin ciclos encolados todavía
+    atomic_store(&process_info->dispatched_at, 0);// Sin despachos pendientes
+    pthread_mutex_init(&process_info->park_mutex, NULL);// Inicializar el mutex de estacionamiento
+    pthread_cond_init(&process_info->park_cond, NULL);// Inicializar la condición de estacionamiento
     update_process_state(process_info, READY);// Actualizar el estado del proceso a READY
-    pthread_create(&process_info->thread_id, NULL, process_main_thread, process_info);// Crear el hilo del proceso principal
 }
 
-void stop_process_thread(ProcessInfo* process_info) {// Detener el hilo del proceso principal (si está en ejecución)
+void stop_process_thread(ProcessInfo* process_info) {// Esperar a que termine el ciclo en curso del proceso (si lo hay)
     if (!process_info || !process_info->pcb) return;// Comprobar si se proporcionó un proceso y un PCB
 
+    process_info->hive->should_terminate = 1;// No se aceptan más ciclos para esta colmena
+    pthread_mutex_lock(&process_info->park_mutex);// Bloquear el mutex de estacionamiento
+    while (atomic_load(&process_info->tick_pending)) {// Mientras un trabajador esté ejecutando su ciclo
+        pthread_cond_wait(&process_info->park_cond, &process_info->park_mutex);// Dormir hasta que el ciclo termine
+    }
+    pthread_mutex_unlock(&process_info->park_mutex);// Desbloquear el mutex de estacionamiento
     if (process_info->pcb->state != READY) {// Comprobar si el estado del PCB no es READY
         update_process_state(process_info, READY);// Actualizar el estado del PCB a READY
-        pthread_join(process_info->thread_id, NULL);// Unir al hilo del proceso principal
     }
 }
 
-void* process_main_thread(void* arg) {// El hilo del proceso principal (se ejecuta en un nuevo proceso)
-    ProcessInfo* process_info = (ProcessInfo*)arg;// Obtener el PCB del proceso principal
-    Beehive* hive = process_info->hive;// Obtener la colmena del proceso principal (para acceder a los recursos)
+static void park_hive_tick(ProcessInfo* process_info) {// Estacionar la colmena cuyo ciclo reclamado no llegó a encolarse
+    pthread_mutex_lock(&process_info->park_mutex);// Bloquear el mutex de estacionamiento
+    atomic_store(&process_info->tick_pending, false);// Ningún ciclo pendiente
+    pthread_cond_broadcast(&process_info->park_cond);// Despertar a quien espera que la colmena se detenga
+    pthread_mutex_unlock(&process_info->park_mutex);// Desbloquear el mutex de estacionamiento
+}
+
+void submit_hive_tick(ProcessInfo* process_info) {// Encolar un ciclo de la colmena en el pool de trabajadores
+    if (!process_info || !process_info->hive || process_info->hive->should_terminate) return;// Comprobar si la colmena sigue activa
+
+    if (atomic_exchange(&process_info->tick_pending, true)) return;// Si ya hay un ciclo pendiente, no se encola otro
+    if (!thread_pool_submit(&scheduler_state.worker_pool, run_hive_tick, process_info)) {// El pool ya se está cerrando
+        park_hive_tick(process_info);// Sin ciclo encolado la colmena queda estacionada
+    }
+}
+
+void run_hive_tick(void* arg) {// Ejecutar un ciclo de trabajo de la colmena (tarea del pool)
+    ProcessInfo* process_info = (ProcessInfo*)arg;// Obtener el proceso de la colmena
+    Beehive* hive = process_info->hive;// Obtener la colmena del proceso (para acceder a los recursos)
+
+    clock_ns_t dispatched_at = atomic_exchange(&process_info->dispatched_at, 0);// Despacho pendiente de atender
+    if (dispatched_at != 0) {// Si este ciclo atiende un despacho
+        record_dispatch_latency(clock_now_ns() - dispatched_at);// Medir la latencia de despacho
+    }
 
-    while (!hive->should_terminate) {// Mientras no se debe terminar el proceso principal
+    if (!hive->should_terminate) {// Comprobar si no se debe terminar la colmena
         sem_wait(process_info->shared_resource_sem);// Esperar a que se produzca una operación en el PCB
         
         if (process_info->pcb->state == RUNNING) {// Comprobar si el estado del PCB es RUNNING
@@ -212,233 +315,307 @@ void* process_main_thread(void* arg) {// El hilo del proceso principal (se ejecu
             manage_polen_collection(process_info);// Gestionar la recolección de polen
             manage_bee_lifecycle(process_info);// Gestionar la vida de las abejas
             print_beehive_stats(process_info);// Imprimir las estadísticas de la colmena
+            update_ready_queue_priority(process_info);// Reubicar la colmena si fue devuelta a la cola de listos durante el ciclo
         }
 
         sem_post(process_info->shared_resource_sem);// Liberar el semáforo del PCB
-        delay_ms(1000);// Retrasar el programa por un número de milisegundos
     }
-    return NULL;// Devolver NULL para indicar que se ha finalizado el hilo
+
+    // Tras publicar tick_pending = false la colmena puede liberarse: toda decisión se toma antes, con el mutex tomado
+    pthread_mutex_lock(&process_info->park_mutex);// Bloquear el mutex de estacionamiento
+    atomic_store(&process_info->tick_pending, false);// El ciclo terminó (un despacho que llegue ahora ya encola su propio ciclo)
+    bool redispatch = false;// Indica si este trabajador debe volver a encolar el ciclo
+    if (!hive->should_terminate && atomic_load(&process_info->dispatched_at) != 0) {// La despacharon de nuevo mientras trabajaba (expulsarla anula el despacho)
+        redispatch = !atomic_exchange(&process_info->tick_pending, true);// Reclamar el ciclo salvo que el despacho ya lo haya encolado
+    }
+    if (!atomic_load(&process_info->tick_pending)) {// La colmena queda realmente estacionada
+        pthread_cond_broadcast(&process_info->park_cond);// Despertar a quien espera que la colmena se detenga
+    }
+    pthread_mutex_unlock(&process_info->park_mutex);// Desbloquear el mutex de estacionamiento
+
+    if (redispatch && !thread_pool_submit(&scheduler_state.worker_pool, run_hive_tick, process_info)) {// Atender el despacho en cuanto queda libre (stop_process_thread espera a ese ciclo)
+        park_hive_tick(process_info);// El pool se está cerrando: la colmena queda estacionada
+    }
+}
+
+void run_hive_epoch_tick(ProcessInfo* process_info) {// Ejecutar un ciclo de la colmena en el modo por épocas (sin planificador ni PCB)
+    if (!process_info || !process_info->hive || process_info->hive->should_terminate) return;// Comprobar si la colmena sigue activa
+
+    manage_honey_production(process_info);// Gestionar la producción de miel
+    manage_polen_collection(process_info);// Gestionar la recolección de polen
+    manage_bee_lifecycle(process_info);// Gestionar la vida de las abejas
+    print_beehive_stats(process_info);// Imprimir las estadísticas de la colmena
 }
 
 void manage_honey_production(ProcessInfo* process_info) {// Gestionar la producción de miel
     Beehive* hive = process_info->hive;// Obtener la colmena del proceso principal
-    pthread_mutex_lock(&hive->resources.polen_mutex);// Bloquear el mutex de los recursos
+    int polen = atomic_load(&hive->resources.polen_for_honey);// Polen disponible
+    while (polen >= POLEN_TO_HONEY_RATIO// Comprobar si hay polen suficiente para producir miel
+           && !atomic_compare_exchange_weak(&hive->resources.polen_for_honey, &polen, polen % POLEN_TO_HONEY_RATIO)) {// Reclamar el polen convertible sin bloquear a la recolección
+    }
 
-    if (hive->resources.polen_for_honey >= POLEN_TO_HONEY_RATIO) {// Comprobar si hay polen suficiente para producir miel
-        int honey_to_produce = hive->resources.polen_for_honey / POLEN_TO_HONEY_RATIO;// Obtener la cantidad de miel a producir
-        hive->resources.polen_for_honey %= POLEN_TO_HONEY_RATIO;// Restar el polen restante
+    if (polen >= POLEN_TO_HONEY_RATIO) {// Comprobar si se reclamó polen para producir miel
+        int honey_to_produce = polen / POLEN_TO_HONEY_RATIO;// Obtener la cantidad de miel a producir
 
-        printf("\nColmena #%d - Iniciando producción de miel:\n", hive->id);// Imprimir el mensaje de inicio de producción de miel
-        printf("├─ Polen disponible: %d unidades\n", hive->resources.polen_for_honey);// Imprimir el polen disponible
-        printf("└─ Miel a producir: %d unidades\n", honey_to_produce);// Imprimir la cantidad de miel a producir
+        log_printf("\nColmena #%d - Iniciando producción de miel:\n", hive->id);// Imprimir el mensaje de inicio de producción de miel
+        log_printf("├─ Polen disponible: %d unidades\n", hive->resources.polen_for_honey);// Imprimir el polen disponible
+        log_printf("└─ Miel a producir: %d unidades\n", honey_to_produce);// Imprimir la cantidad de miel a producir
 
-        pthread_mutex_lock(&hive->chamber_mutex);// Bloquear el mutex de las cámaras
         int honey_produced = 0;// Inicializar el número de miel producido
 
-        for (int c = 0; c < NUM_CHAMBERS && honey_to_produce > 0; c++) {// Recorrer todas las cámaras
+        ChamberSet candidates = atomic_load(&hive->honey_space);// Solo las cámaras con sitio para miel
+        while (honey_to_produce > 0 && candidates) {// Recorrer las cámaras con sitio en orden
+            int c = chamber_set_pop(&candidates);// Siguiente cámara con sitio
             Chamber* chamber = &hive->chambers[c];// Obtener la cámara actual (para calcular la posición vacía)
-            if (chamber->honey_count >= MAX_HONEY_PER_CHAMBER) continue;// Comprobar si la cámara está llena
-
-            int x, y;// Posición vacía
-            while (honey_to_produce > 0 && chamber->honey_count < MAX_HONEY_PER_CHAMBER && find_empty_cell_for_honey(chamber, &x, &y)) {// Mientras haya polen y la cámara no esté llena
-                chamber->cells[x][y].has_honey = true;// Marcar la celda como conteniendo miel
-                chamber->honey_count++;// Incrementar el número de miel
-                hive->honey_count++;// Incrementar el número de miel
-                honey_to_produce--;// Restar el polen restante
-                honey_produced++;// Incrementar el número de miel producido
-            }
+
+            pthread_mutex_lock(&chamber->mutex);// Bloquear solo esta cámara
+            int space = MAX_HONEY_PER_CHAMBER - chamber->honey_count;// Miel que cabe en la cámara (puede haberse llenado desde la instantánea)
+            int honey = cell_mask_fill(&chamber->honey_mask, &HONEY_ZONE, honey_to_produce < space ? honey_to_produce : space, NULL);// Ocupar las celdas libres en bloque
+            chamber->honey_count += honey;// Incrementar el número de miel
+            refresh_chamber_space(hive, c);// La cámara puede haberse llenado
+            pthread_mutex_unlock(&chamber->mutex);// Desbloquear la cámara
+
+            add_hive_honey(hive, honey);// Incrementar el número de miel (y la clave de FSJ)
+            honey_to_produce -= honey;// Restar el polen restante
+            honey_produced += honey;// Incrementar el número de miel producido
         }
 
         if (honey_produced > 0) {// Comprobar si se produjo algún miel
             hive->produced_honey += honey_produced;// Incrementar el total de miel producido
-            update_bees_and_honey_count(hive);// Actualizar el contador de abejas + miel
-            printf("\nColmena #%d - Producción completada:\n", hive->id);// Imprimir el mensaje de producción completada
-            printf("├─ Miel producida: %d unidades\n", honey_produced);// Imprimir la cantidad de miel producido
-            printf("└─ Total de miel en la colmena: %d/%d\n", hive->honey_count, MAX_HONEY_PER_HIVE);// Imprimir el total de miel en la colmena
+            log_printf("\nColmena #%d - Producción completada:\n", hive->id);// Imprimir el mensaje de producción completada
+            log_printf("├─ Miel producida: %d unidades\n", honey_produced);// Imprimir la cantidad de miel producido
+            log_printf("└─ Total de miel en la colmena: %d/%d\n", hive->honey_count, MAX_HONEY_PER_HIVE);// Imprimir el total de miel en la colmena
         }
-
-        pthread_mutex_unlock(&hive->chamber_mutex);// Desbloquear el mutex de las cámaras
     }
-    pthread_mutex_unlock(&hive->resources.polen_mutex);// Desbloquear el mutex de los recursos
 }
 
 void manage_polen_collection(ProcessInfo* process_info) {// Gestionar la recolección de polen
     Beehive* hive = process_info->hive;// Obtener la colmena del proceso principal
-    pthread_mutex_lock(&hive->chamber_mutex);// Bloquear el mutex de las cámaras
-    time_t current_time = time(NULL);// Obtener la hora actual (para calcular el tiempo de recolección)
-    int active_workers = 0;// Inicializar el número de abejas activas
-    int total_polen_collected_this_round = 0;// Inicializar el total de polen recolectado en esta ronda
+    BeeColony* bees = &hive->bees;// Abejas de la colmena
+    pthread_mutex_lock(&hive->bees_mutex);// Bloquear solo las abejas (la recolección no toca las cámaras)
+    BeeSet active = bees->alive & bees->workers;// Obreras vivas que salen a recolectar (solo se recorren huecos ocupados)
+    int active_workers = __builtin_popcountll(active);// Número de abejas activas
+    int values[BEE_CAPACITY];// Cantidades de polen sorteadas en lote
+    int32_t draws[BEE_CAPACITY] = {0};// Polen de cada carril (0 en los inactivos)
+
+    log_printf("\nColmena #%d - Recolección de polen:\n", hive->id);// Imprimir el mensaje de recolección de polen
+
+    rng_fill_range(&hive->rng, values, active_workers, MIN_POLEN_PER_TRIP, MAX_POLEN_PER_TRIP);// Un sorteo por obrera activa
+    int k = 0;// Siguiente cantidad del lote
+    for (BeeSet set = active; set; set &= set - 1) {// Repartir el lote en los carriles activos
+        draws[__builtin_ctzll(set)] = values[k++];// Polen de la abeja
+    }
 
-    printf("\nColmena #%d - Recolección de polen:\n", hive->id);// Imprimir el mensaje de recolección de polen
+    BeeSet reached;// Abejas que alcanzaron su límite de vida
+    int total_polen_collected_this_round = collect_polen(bees->polen_collected, draws, bees->polen_lifetime, BEE_CAPACITY, &reached);// Acumular y comparar todos los carriles de una vez
+    bees->last_collection_time = clock_coarse_now_ns();// Guardar la hora de la última recolección de polen
 
-    for (int i = 0; i < hive->bee_count; i++) {// Recorrer todas las abejas
-        if (hive->bees[i].type == WORKER && hive->bees[i].is_alive) {// Comprobar si la abeja es una obrera y está viva
-            active_workers++;// Incrementar el número de abejas activas
-            int polen = random_range(MIN_POLEN_PER_TRIP, MAX_POLEN_PER_TRIP);// Obtener el número de polen
-            
-            pthread_mutex_lock(&hive->resources.polen_mutex);// Bloquear el mutex de los recursos
-            hive->resources.total_polen += polen;// Incrementar el total de polen
-            hive->resources.polen_for_honey += polen;// Incrementar el polen disponible para miel
-            hive->resources.total_polen_collected += polen;// Incrementar el total de polen recolectado
-            hive->bees[i].polen_collected += polen;// Incrementar el polen recolectado de la abeja
-            total_polen_collected_this_round += polen;// Incrementar el total de polen recolectado en esta ronda
-            
-            printf("├─ Abeja #%d: %d polen (Total: %d/%d)\n", i, polen, hive->bees[i].polen_collected, random_range(MIN_POLEN_LIFETIME, MAX_POLEN_LIFETIME));// Imprimir el mensaje de recolección de polen
-            
-            pthread_mutex_unlock(&hive->resources.polen_mutex);// Desbloquear el mutex de los recursos
-            hive->bees[i].last_collection_time = current_time;// Guardar la hora de la última recolección de polen
-
-            // Verificar muerte de abeja
-            if (hive->bees[i].polen_collected >= random_range(MIN_POLEN_LIFETIME, MAX_POLEN_LIFETIME)) {// Comprobar si la abeja ha muerto
-                handle_bee_death(process_info, i);// Manejar la muerte de la abeja
-            }
+    atomic_fetch_add(&hive->resources.total_polen, total_polen_collected_this_round);// Incrementar el total de polen
+    atomic_fetch_add(&hive->resources.polen_for_honey, total_polen_collected_this_round);// Incrementar el polen disponible para miel
+    atomic_fetch_add(&hive->resources.total_polen_collected, total_polen_collected_this_round);// Incrementar el total de polen recolectado
+
+    if (!quiet_output) {// El detalle por abeja solo se recorre si se va a imprimir
+        for (BeeSet set = active; set; set &= set - 1) {// Recorrer las obreras activas
+            int i = __builtin_ctzll(set);// Índice de la abeja
+            log_printf("├─ Abeja #%d: %d polen (Total: %d/%d)\n", i, draws[i], bees->polen_collected[i], bees->polen_lifetime[i]);// Imprimir el mensaje de recolección de polen
         }
     }
 
-    printf("└─ Resumen de recolección:\n");// Imprimir el resumen de recolección
-    printf("    ├─ Polen recolectado: %d unidades\n", total_polen_collected_this_round);// Imprimir el total de polen recolectado en esta ronda
-    printf("    └─ Polen total acumulado: %d unidades\n", hive->resources.total_polen_collected);// Imprimir el total de polen acumulado
+    // Verificar muerte de abejas
+    for (BeeSet dead = reached & active; dead; dead &= dead - 1) {// Obreras que alcanzaron su límite de vida
+        handle_bee_death(process_info, __builtin_ctzll(dead));// Manejar la muerte de la abeja
+    }
+
+    log_printf("└─ Resumen de recolección:\n");// Imprimir el resumen de recolección
+    log_printf("    ├─ Obreras activas: %d (núcleo %s)\n", active_workers, polen_kernel_name());// Imprimir las obreras y el núcleo usado
+    log_printf("    ├─ Polen recolectado: %d unidades\n", total_polen_collected_this_round);// Imprimir el total de polen recolectado en esta ronda
+    log_printf("    └─ Polen total acumulado: %d unidades\n", hive->resources.total_polen_collected);// Imprimir el total de polen acumulado
 
-    pthread_mutex_unlock(&hive->chamber_mutex);// Desbloquear el mutex de las cámaras
+    pthread_mutex_unlock(&hive->bees_mutex);// Desbloquear las abejas
 }
 
-void manage_bee_lifecycle(ProcessInfo* process_info) {// Gestionar la vida de las abejas
-    pthread_mutex_lock(&process_info->hive->chamber_mutex);// Bloquear el mutex de las cámaras
-    
+void manage_bee_lifecycle(ProcessInfo* process_info) {// Gestionar la vida de las abejas (cada paso toma sus propios mutexes)
     // Procesar reina y puesta de huevos
     process_queen_egg_laying(process_info);// Procesar la puesta de huevos de la reina
     
     // Procesar eclosión de huevos
     process_eggs_hatching(process_info);// Procesar la eclosión de huevos
-    
-    pthread_mutex_unlock(&process_info->hive->chamber_mutex);// Desbloquear el mutex de las cámaras
 }
 
-void handle_bee_death(ProcessInfo* process_info, int bee_index) {// Manejar la muerte de una abeja
+void handle_bee_death(ProcessInfo* process_info, int bee_index) {// Manejar la muerte de una abeja (con bees_mutex retenido)
     Beehive* hive = process_info->hive;// Obtener la colmena del proceso principal (para acceder a los recursos y a la colmena)
-    hive->bees[bee_index].is_alive = false;// Marcar la abeja como muerta
-    hive->dead_bees++;// Incrementar el número de abejas muertas
-    hive->bee_count--;// Restar el número de abejas
-    update_bees_and_honey_count(hive);// Actualizar el contador de abejas + miel
+    BeeColony* bees = &hive->bees;// Abejas de la colmena
+    bees->alive &= ~((BeeSet)1 << bee_index);// Marcar la abeja como muerta (el hueco queda libre)
+    bees->generation[bee_index]++;// Invalidar las referencias a esta abeja
+    count_bee_death(hive, (bees->workers >> bee_index) & 1 ? WORKER : QUEEN);// Actualizar los agregados
     
-    printf("\nColmena #%d - Muerte de abeja:\n", hive->id);// Imprimir el mensaje de muerte de abeja
-    printf("├─ Abeja #%d (%s) ha muerto\n", bee_index, hive->bees[bee_index].type == QUEEN ? "REINA" : "OBRERA");// Imprimir el número de abeja y su tipo
-    printf("├─ Polen recolectado en su vida: %d unidades\n", hive->bees[bee_index].polen_collected);// Imprimir el polen recolectado en su vida
-    printf("└─ Total de abejas muertas: %d\n", hive->dead_bees);// Imprimir el total de abejas muertas
+    log_printf("\nColmena #%d - Muerte de abeja:\n", hive->id);// Imprimir el mensaje de muerte de abeja
+    log_printf("├─ Abeja #%d (%s) ha muerto\n", bee_index, (bees->workers >> bee_index) & 1 ? "OBRERA" : "REINA");// Imprimir el número de abeja y su tipo
+    log_printf("├─ Polen recolectado en su vida: %d unidades\n", bees->polen_collected[bee_index]);// Imprimir el polen recolectado en su vida
+    log_printf("└─ Total de abejas muertas: %d\n", hive->dead_bees);// Imprimir el total de abejas muertas
 }
 
-void create_new_bee(ProcessInfo* process_info, BeeType type) {// Crear una abeja nueva
+BeeHandle create_new_bee(ProcessInfo* process_info, BeeType type) {// Crear una abeja nueva (con bees_mutex retenido)
     Beehive* hive = process_info->hive;// Obtener la colmena del proceso principal (para acceder a los recursos y a la colmena)
-    if (hive->bee_count >= MAX_BEES) return;// Comprobar si se ha alcanzado el límite de abejas
-
-    int new_bee_index = hive->bee_count++;// Obtener el índice de la abeja nueva (para asignar el tipo de la abeja)
-    hive->bees = realloc(hive->bees, sizeof(Bee) * hive->bee_count);// utilizar realloc para cambiar el tamaño de la colmena
-    
-    Bee* new_bee = &hive->bees[new_bee_index];// Obtener la abeja nueva
-    new_bee->id = new_bee_index;// Asignar el ID de la abeja
-    new_bee->type = type;// Asignar el tipo de la abeja
-    new_bee->polen_collected = 0;// Inicializar el polen recolectado
-    new_bee->is_alive = true;// Inicializar la vida de la abeja
-    new_bee->last_collection_time = time(NULL);// Guardar la hora de la última recolección de polen
-    new_bee->last_egg_laying_time = time(NULL);// Guardar la hora de la última puesta de huevos
+    BeeColony* bees = &hive->bees;// Abejas de la colmena
+    BeeSet free_slots = bee_range(MAX_BEES) & ~bees->alive;// Huecos libres
+    if (!free_slots) return BEE_HANDLE_NONE;// Comprobar si se ha alcanzado el límite de abejas
+
+    int slot = __builtin_ctzll(free_slots);// Menor hueco libre (O(1), sin reservar memoria)
+    BeeSet bit = (BeeSet)1 << slot;// Bit de la abeja nueva
+    bees->alive |= bit;// Inicializar la vida de la abeja
+    if (type == WORKER) bees->workers |= bit;// Asignar el tipo de la abeja
+    else bees->workers &= ~bit;// Reina
+    bees->polen_collected[slot] = 0;// Inicializar el polen recolectado
+    bees->polen_lifetime[slot] = rng_range(&hive->brood_rng, MIN_POLEN_LIFETIME, MAX_POLEN_LIFETIME);// Sortear su límite de vida
     
     hive->born_bees++;// Incrementar el número de abejas nacidas
-    update_bees_and_honey_count(hive);// Actualizar el contador de abejas + miel
+    count_bee_birth(hive, type);// Actualizar los agregados
+    return bee_handle(bees, slot);// Referencia a la abeja nueva
 }
 
 void process_eggs_hatching(ProcessInfo* process_info) {// Procesar la eclosión de huevos
     Beehive* hive = process_info->hive;// Obtener la colmena del proceso principal (para acceder a los recursos y a la colmena)
-    time_t current_time = time(NULL);// Obtener la hora actual (para calcular el tiempo de puesta de huevos)
-    int queen_count = count_queen_bees(process_info);// Obtener el número de reinas
+    clock_ns_t current_time = clock_now_ns();// Obtener la hora actual (para calcular el tiempo de puesta de huevos)
+    CellMask hatched[NUM_CHAMBERS] = {0};// Celdas que se vacían en cada cámara
     int eggs_hatched = 0;// Inicializar el número de huevos eclosionados
 
-    printf("\nColmena #%d - Procesando eclosión de huevos:\n", hive->id);// Imprimir el mensaje de eclosión de huevos
+    log_printf("\nColmena #%d - Procesando eclosión de huevos:\n", hive->id);// Imprimir el mensaje de eclosión de huevos
+
+    // Fase 1: separar de la rueda los huevos vencidos (solo hatch_mutex)
+    pthread_mutex_lock(&hive->hatch_mutex);// Bloquear la rueda de eclosión
+    HatchWheel* wheel = &hive->hatch_wheel;// Rueda de eclosión de la colmena
+    uint64_t now_slot = (uint64_t)current_time / HATCH_WHEEL_GRANULARITY_NS;// Ranura absoluta actual
+    uint64_t first_slot = wheel->cursor;// Primera ranura sin revisar
+    if (now_slot - first_slot >= HATCH_WHEEL_SLOTS) first_slot = now_slot - (HATCH_WHEEL_SLOTS - 1);// Tras más de una vuelta basta revisar cada ranura una vez
+
+    for (uint64_t s = first_slot; s <= now_slot; s++) {// Recorrer solo las ranuras vencidas
+        int slot = (int)(s & (HATCH_WHEEL_SLOTS - 1));// Ranura en la rueda
+        uint16_t egg = wheel->head[slot];// Primer huevo de la ranura
+        uint16_t kept_head = HATCH_NONE, kept_tail = HATCH_NONE;// Huevos de una vuelta posterior que siguen en la ranura
+        while (egg != HATCH_NONE) {// Recorrer la lista de la ranura
+            int c = egg / CHAMBER_CELLS;// Cámara del huevo
+            int index = egg % CHAMBER_CELLS;// Celda del huevo
+            EggCell* cell = egg_cell(hive, egg);// Datos de eclosión del huevo
+            uint16_t next = cell->hatch_next;// Siguiente huevo de la ranura
+
+            if (wheel->base + cell->hatch_tick > now_slot) {// Aún no vence (solo ocurre al revisar la rueda entera)
+                cell->hatch_next = HATCH_NONE;// Será el último de los que siguen
+                if (kept_tail == HATCH_NONE) {// Primer huevo que sigue
+                    kept_head = egg;// Nueva cabeza
+                } else {// Enlazar detrás del anterior
+                    egg_cell(hive, kept_tail)->hatch_next = egg;// Enlazar
+                }
+                kept_tail = egg;// Nuevo último
+                egg = next;// Siguiente huevo
+                continue;// No eclosiona todavía
+            }
 
-    for (int c = 0; c < NUM_CHAMBERS; c++) {// Recorrer todas las cámaras
-        Chamber* chamber = &hive->chambers[c];// Obtener la cámara actual (para calcular la posición vacía)
-        for (int x = 0; x < MAX_CHAMBER_SIZE; x++) {// Recorrer todas las filas
-            for (int y = 0; y < MAX_CHAMBER_SIZE; y++) {// Recorrer todas las columnas
-                if (chamber->cells[x][y].has_egg) {// Comprobar si la celda tiene huevo
-                    double elapsed_time = difftime(current_time, chamber->cells[x][y].egg_lay_time) * 1000;// Obtener el tiempo transcurrido desde la última puesta de huevos
-                    if (elapsed_time >= MAX_EGG_HATCH_TIME) {// Comprobar si el tiempo transcurrido es superior al límite de tiempo de eclosión
-                        chamber->cells[x][y].has_egg = false;// Marcar la celda como vacía
-                        chamber->egg_count--;// Restar el número de huevos
-                        hive->egg_count--;// Restar el número de huevos
-                        hive->hatched_eggs++;// Incrementar el número de huevos eclosionados
-                        eggs_hatched++;// Incrementar el número de huevos eclosionados
-
-                        if (hive->bee_count < MAX_BEES) {// Comprobar si se ha alcanzado el límite de abejas
-                            bool will_be_queen = (random_range(1, 100) <= QUEEN_BIRTH_PROBABILITY);// Comprobar si se va a nacer una reina
-                            if (will_be_queen && queen_count == 1) {// Comprobar si hay una reina
-                                hive->should_create_new_hive = true;// Indicar que se debe crear una nueva colmena
-                                printf("├─ ¡Nueva reina nacerá! Se creará una nueva colmena\n");// Imprimir el mensaje de nacimiento de reina
-                            } else {// Si no es una reina
-                                create_new_bee(process_info, WORKER);// Crear una abeja nueva
-                            }
-                        }
-                    }
+            eggs_hatched++;// Eclosiona en este ciclo
+            cell_mask_set(&hatched[c], index);// Celda a vaciar
+            egg = next;// Siguiente huevo
+        }
+        wheel->head[slot] = kept_head;// La ranura queda con los huevos que no vencieron
+        wheel->tail[slot] = kept_tail;// Último de ellos
+    }
+    wheel->cursor = now_slot;// La ranura actual se vuelve a revisar la próxima vez (pueden llegar huevos que vencen en ella)
+    pthread_mutex_unlock(&hive->hatch_mutex);// Desbloquear la rueda de eclosión
+
+    // Fase 2: vaciar las celdas, bloqueando cada cámara una sola vez
+    for (int c = 0; c < NUM_CHAMBERS && eggs_hatched > 0; c++) {// Recorrer las cámaras
+        int count = cell_mask_count(&hatched[c]);// Huevos que eclosionan en la cámara
+        if (count == 0) continue;// Nada que vaciar
+        Chamber* chamber = &hive->chambers[c];// Obtener la cámara de los huevos
+        pthread_mutex_lock(&chamber->mutex);// Bloquear solo esta cámara
+        cell_mask_remove(&chamber->egg_mask, &hatched[c]);// Marcar las celdas como vacías
+        chamber->egg_count -= count;// Restar el número de huevos
+        refresh_chamber_space(hive, c);// La cámara vuelve a tener sitio para huevos
+        pthread_mutex_unlock(&chamber->mutex);// Desbloquear la cámara
+    }
+    atomic_fetch_sub(&hive->egg_count, eggs_hatched);// Restar el número de huevos
+    hive->hatched_eggs += eggs_hatched;// Incrementar el número de huevos eclosionados
+
+    // Fase 3: nacimientos (solo bees_mutex)
+    if (eggs_hatched > 0) {// Comprobar si nace alguna abeja
+        pthread_mutex_lock(&hive->bees_mutex);// Bloquear las abejas
+        int queen_count = count_queen_bees(process_info);// Obtener el número de reinas
+        for (int k = 0; k < eggs_hatched; k++) {// Un nacimiento por huevo eclosionado
+            if (hive->bee_count < MAX_BEES) {// Comprobar si se ha alcanzado el límite de abejas
+                bool will_be_queen = (rng_range(&hive->brood_rng, 1, 100) <= QUEEN_BIRTH_PROBABILITY);// Comprobar si se va a nacer una reina
+                if (will_be_queen && queen_count == 1) {// Comprobar si hay una reina
+                    atomic_store(&hive->should_create_new_hive, true);// Indicar que se debe crear una nueva colmena
+                    log_printf("├─ ¡Nueva reina nacerá! Se creará una nueva colmena\n");// Imprimir el mensaje de nacimiento de reina
+                } else {// Si no es una reina
+                    create_new_bee(process_info, WORKER);// Crear una abeja nueva
                 }
             }
         }
+        pthread_mutex_unlock(&hive->bees_mutex);// Desbloquear las abejas
     }
 
     if (eggs_hatched > 0) {// Comprobar si se produjo algún huevo eclosionado
-        printf("└─ Resumen de eclosiones:\n");// Imprimir el resumen de eclosiones
-        printf("    ├─ Huevos eclosionados en este ciclo: %d\n", eggs_hatched);// Imprimir el número de huevos eclosionados en este ciclo
-        printf("    ├─ Total de huevos eclosionados: %d\n", hive->hatched_eggs);// Imprimir el total de huevos eclosionados
-        printf("    └─ Huevos restantes: %d\n", hive->egg_count);// Imprimir el número de huevos restantes
+        log_printf("└─ Resumen de eclosiones:\n");// Imprimir el resumen de eclosiones
+        log_printf("    ├─ Huevos eclosionados en este ciclo: %d\n", eggs_hatched);// Imprimir el número de huevos eclosionados en este ciclo
+        log_printf("    ├─ Total de huevos eclosionados: %d\n", hive->hatched_eggs);// Imprimir el total de huevos eclosionados
+        log_printf("    └─ Huevos restantes: %d\n", hive->egg_count);// Imprimir el número de huevos restantes
     } else {// Si no se produjo huevo eclosionado
-        printf("└─ No hay huevos listos para eclosionar\n");// Imprimir que no hay huevos listos para eclosionar
+        log_printf("└─ No hay huevos listos para eclosionar\n");// Imprimir que no hay huevos listos para eclosionar
     }
 }
 
 void process_queen_egg_laying(ProcessInfo* process_info) {// Procesar la puesta de huevos de la reina
     Beehive* hive = process_info->hive;// Obtener la colmena del proceso principal (para acceder a los recursos y a la colmena)
-    printf("\nColmena #%d - Actividad de la reina:\n", hive->id);// Imprimir el mensaje de puesta de huevos de la reina
+    log_printf("\nColmena #%d - Actividad de la reina:\n", hive->id);// Imprimir el mensaje de puesta de huevos de la reina
 
     // Encontrar la reina
-    for (int i = 0; i < hive->bee_count; i++) {// Recorrer todas las abejas
-        if (hive->bees[i].type == QUEEN && hive->bees[i].is_alive) {// Comprobar si la abeja es una reina y está viva
-            int eggs_to_lay = random_range(MIN_EGGS_PER_LAYING, MAX_EGGS_PER_LAYING);// Obtener el número de huevos a poner
-            printf("├─ Reina #%d intentará poner %d huevos\n", i, eggs_to_lay);// Imprimir el mensaje de puesta de huevos de la reina
-            
-            int eggs_laid = 0;// Inicializar el número de huevos puestos
-            // Intentar poner huevos en cámaras disponibles
-            for (int c = 0; c < NUM_CHAMBERS && eggs_to_lay > 0; c++) {// Recorrer todas las cámaras
-                Chamber* chamber = &hive->chambers[c];// Obtener la cámara actual (para calcular la posición vacía)
-                if (chamber->egg_count >= MAX_EGGS_PER_CHAMBER ||
-                    hive->egg_count >= MAX_EGGS_PER_HIVE) continue;// Comprobar si se ha alcanzado el límite de huevos
-
-                int x, y;
-                while (eggs_to_lay > 0 && chamber->egg_count < MAX_EGGS_PER_CHAMBER && find_empty_cell_for_egg(chamber, &x, &y)) {// Mientras hay huevos restantes y la cámara no esté llena
-                    chamber->cells[x][y].has_egg = true;// Marcar la celda como conteniendo huevo
-                    chamber->cells[x][y].egg_lay_time = time(NULL);// Guardar la hora de la última puesta de huevos
-                    chamber->egg_count++;// Incrementar el número de huevos
-                    hive->egg_count++;// Incrementar el número de huevos
-                    eggs_to_lay--;// Restar el número de huevos
-                    eggs_laid++;// Incrementar el número de huevos puestos
-                }
+    pthread_mutex_lock(&hive->bees_mutex);// Bloquear las abejas solo para localizar la reina
+    int i = hive->aggregates.queens > 0 ? __builtin_ctzll(hive->bees.alive & ~hive->bees.workers) : -1;// Solo procesar una reina por vez (la de menor índice)
+    pthread_mutex_unlock(&hive->bees_mutex);// Desbloquear las abejas
+
+    if (i >= 0) {// Comprobar si hay reina
+        int eggs_to_lay = rng_range(&hive->brood_rng, MIN_EGGS_PER_LAYING, MAX_EGGS_PER_LAYING);// Obtener el número de huevos a poner
+        log_printf("├─ Reina #%d intentará poner %d huevos\n", i, eggs_to_lay);// Imprimir el mensaje de puesta de huevos de la reina
+        
+        uint16_t laid_eggs[MAX_EGGS_PER_LAYING];// Huevos puestos en esta tanda (se encolan en la rueda al final)
+        int eggs_laid = 0;// Inicializar el número de huevos puestos
+        clock_ns_t lay_time = clock_now_ns();// Hora de puesta común a toda la tanda
+        // Intentar poner huevos en cámaras disponibles
+        ChamberSet candidates = atomic_load(&hive->egg_space);// Solo las cámaras con sitio para huevos
+        while (eggs_to_lay > 0 && candidates && hive->egg_count < MAX_EGGS_PER_HIVE) {// Recorrer las cámaras con sitio mientras la colmena admita huevos
+            int c = chamber_set_pop(&candidates);// Siguiente cámara con sitio
+            Chamber* chamber = &hive->chambers[c];// Obtener la cámara actual (para calcular la posición vacía)
+
+            pthread_mutex_lock(&chamber->mutex);// Bloquear solo esta cámara
+            int space = MAX_EGGS_PER_CHAMBER - chamber->egg_count;// Huevos que caben en la cámara (puede haberse llenado desde la instantánea)
+            CellMask laid;// Celdas ocupadas en esta tanda
+            int eggs = cell_mask_fill(&chamber->egg_mask, &EGG_ZONE, eggs_to_lay < space ? eggs_to_lay : space, &laid);// Ocupar las celdas libres en bloque
+            for (int index = cell_mask_pop(&laid); index >= 0; index = cell_mask_pop(&laid)) {// Recorrer solo las celdas nuevas
+                laid_eggs[eggs_laid++] = (uint16_t)(c * CHAMBER_CELLS + index);// Pendiente de encolar su eclosión
             }
-            
-            printf("└─ Resultado de puesta:\n");// Imprimir el resultado de la puesta de huevos
-            printf("    ├─ Huevos puestos: %d\n", eggs_laid);// Imprimir el número de huevos puestos
-            printf("    ├─ Total de huevos en la colmena: %d/%d\n", hive->egg_count, MAX_EGGS_PER_HIVE);// Imprimir el total de huevos en la colmena
-            printf("    └─ Capacidad restante: %d huevos\n", MAX_EGGS_PER_HIVE - hive->egg_count);// Imprimir la capacidad restante de huevos
-            
-            break; // Solo procesar una reina por vez
+            chamber->egg_count += eggs;// Incrementar el número de huevos
+            refresh_chamber_space(hive, c);// La cámara puede haberse llenado
+            pthread_mutex_unlock(&chamber->mutex);// Desbloquear la cámara
+
+            atomic_fetch_add(&hive->egg_count, eggs);// Incrementar el número de huevos
+            eggs_to_lay -= eggs;// Restar el número de huevos
+        }
+
+        pthread_mutex_lock(&hive->hatch_mutex);// Bloquear la rueda una vez para toda la tanda (sin ninguna cámara retenida)
+        for (int k = 0; k < eggs_laid; k++) {// Recorrer los huevos puestos en orden
+            schedule_egg_hatch(hive, laid_eggs[k] / CHAMBER_CELLS, laid_eggs[k] % CHAMBER_CELLS, lay_time);// Encolar su eclosión
         }
+        pthread_mutex_unlock(&hive->hatch_mutex);// Desbloquear la rueda
+        
+        log_printf("└─ Resultado de puesta:\n");// Imprimir el resultado de la puesta de huevos
+        log_printf("    ├─ Huevos puestos: %d\n", eggs_laid);// Imprimir el número de huevos puestos
+        log_printf("    ├─ Total de huevos en la colmena: %d/%d\n", hive->egg_count, MAX_EGGS_PER_HIVE);// Imprimir el total de huevos en la colmena
+        log_printf("    └─ Capacidad restante: %d huevos\n", MAX_EGGS_PER_HIVE - hive->egg_count);// Imprimir la capacidad restante de huevos
     }
 }
 
-int count_queen_bees(ProcessInfo* process_info) {// Contar las abejas reinas
+int count_queen_bees(ProcessInfo* process_info) {// Contar las abejas reinas (lectura O(1); exacta con bees_mutex retenido)
     Beehive* hive = process_info->hive;// Obtener la colmena del proceso principal (para acceder a los recursos y a la colmena)
-    int count = 0;// Inicializar el contador
-    for (int i = 0; i < hive->bee_count; i++) {// Recorrer todas las abejas
-        if (hive->bees[i].is_alive && hive->bees[i].type == QUEEN) {// Comprobar si la abeja es una reina y está viva
-            count++;// Incrementar el contador
-        }
-    }
-    return count;// Devolver el número de reinas
+    return hive->aggregates.queens;// Devolver el número de reinas vivas
 }
 
 void print_chamber_row(ProcessInfo* process_info, int start_index, int end_index) {// Imprimir una fila de cámaras
@@ -446,89 +623,77 @@ void print_chamber_row(ProcessInfo* process_info, int start_index, int end_index
     
     // Imprimir números de cámara
     for (int c = start_index; c < end_index; c++) {// Recorrer todas las cámaras
-        printf("Cámara #%d:", c);// Imprimir el número de cámara
-        printf("\t\t\t\t\t");// Imprimir 4 espacios para alinear el texto
+        log_printf("Cámara #%d:", c);// Imprimir el número de cámara
+        log_printf("\t\t\t\t\t");// Imprimir 4 espacios para alinear el texto
     }
-    printf("\n");// Imprimir un salto de línea
+    log_printf("\n");// Imprimir un salto de línea
 
     // Imprimir matrices de cámaras
     for (int i = 0; i < MAX_CHAMBER_SIZE; i++) {// Recorrer todas las filas
         for (int c = start_index; c < end_index; c++) {// Recorrer todas las cámaras
             Chamber* chamber = &hive->chambers[c];// Obtener la cámara actual (para calcular la posición vacía)
             for (int j = 0; j < MAX_CHAMBER_SIZE; j++) {// Recorrer todas las columnas
-                Cell* cell = &chamber->cells[i][j];// Obtener la celda actual (para comprobar si tiene huevo)
-                if (is_egg_position(i, j)) {// Comprobar si la posición está vacía y tiene huevo
-                    printf("H%d ", cell->has_egg ? 1 : 0);// Imprimir el número de huevo (1 si tiene huevo, 0 si no)
+                int index = cell_index(i, j);// Bit de la celda actual
+                if (cell_mask_test(&EGG_ZONE, index)) {// Comprobar si la celda es de la zona de huevos
+                    log_printf("H%d ", cell_mask_test(&chamber->egg_mask, index) ? 1 : 0);// Imprimir el número de huevo (1 si tiene huevo, 0 si no)
                 } else {// Si la posición está vacía y no tiene huevo
-                    printf("M%d ", cell->has_honey ? 1 : 0);// Imprimir el número de miel (1 si tiene miel, 0 si no)
+                    log_printf("M%d ", cell_mask_test(&chamber->honey_mask, index) ? 1 : 0);// Imprimir el número de miel (1 si tiene miel, 0 si no)
                 }
             }
-            printf("\t\t\t");// Imprimir 4 espacios para alinear el texto
+            log_printf("\t\t\t");// Imprimir 4 espacios para alinear el texto
         }
-        printf("\n");// Imprimir un salto de línea
+        log_printf("\n");// Imprimir un salto de línea
     }
 
     // Imprimir estadísticas de cámaras
     for (int c = start_index; c < end_index; c++) {// Recorrer todas las cámaras
         Chamber* chamber = &hive->chambers[c];// Obtener la cámara actual (para calcular la posición vacía)
-        printf("Miel: %d/%d, Huevos: %d/%d\t\t\t", chamber->honey_count, MAX_HONEY_PER_CHAMBER, chamber->egg_count, MAX_EGGS_PER_CHAMBER);// Imprimir el número de miel y huevos
+        log_printf("Miel: %d/%d, Huevos: %d/%d\t\t\t", chamber->honey_count, MAX_HONEY_PER_CHAMBER, chamber->egg_count, MAX_EGGS_PER_CHAMBER);// Imprimir el número de miel y huevos
     }
-    printf("\n\n");// Imprimir un salto de línea
+    log_printf("\n\n");// Imprimir un salto de línea
 }
 
 void print_chamber_matrix(ProcessInfo* process_info) {// Imprimir la matriz de cámaras
-    printf("\nColmena #%d - Estado de las cámaras:\n\n", process_info->hive->id);// Imprimir el mensaje de estado de las cámaras
+    log_printf("\nColmena #%d - Estado de las cámaras:\n\n", process_info->hive->id);// Imprimir el mensaje de estado de las cámaras
     print_chamber_row(process_info, 0, 5);// Imprimir la fila de cámaras
     print_chamber_row(process_info, 5, 10);// Imprimir la fila de cámaras
 }
 
 void print_detailed_bee_status(ProcessInfo* process_info) {// Imprimir el estado detallado de las abejas
     Beehive* hive = process_info->hive;// Obtener la colmena del proceso principal (para acceder a los recursos y a la colmena)
-    int alive_workers = 0, dead_workers = 0;// Inicializar el número de abejas vivas y muertas
-    
-    for (int i = 0; i < hive->bee_count; i++) {// Recorrer todas las abejas
-        if (hive->bees[i].type == WORKER) {// Comprobar si la abeja es un trabajador
-            if (hive->bees[i].is_alive) {// Comprobar si la abeja está viva
-                alive_workers++;// Incrementar el número de abejas vivas
-            } else {// Si la abeja está muerta
-                dead_workers++;// Incrementar el número de abejas muertas
-            }
-        }
-    }
+    int alive_workers = hive->aggregates.alive_workers;// Número de obreras vivas
+    int dead_workers = hive->aggregates.dead_workers;// Número de obreras muertas
     
-    printf("├─ Total de abejas: %d/%d\n", alive_workers + 1, MAX_BEES);// Imprimir el número de abejas y su tipo
-    printf("    ├─ Obreras vivas: %d\n", alive_workers);// Imprimir el número de abejas vivas
-    printf("    ├─ Obreras muertas: %d\n", dead_workers);// Imprimir el número de abejas muertas
-    printf("    ├─ Abejas nacidas: %d\n", hive->born_bees);// Imprimir el número de abejas nacidas
-    printf("    └─ Total de muertes: %d\n", hive->dead_bees);// Imprimir el número de muertes
+    log_printf("├─ Total de abejas: %d/%d\n", hive->bee_count, MAX_BEES);// Imprimir el número de abejas y su tipo
+    log_printf("    ├─ Obreras vivas: %d\n", alive_workers);// Imprimir el número de abejas vivas
+    log_printf("    ├─ Obreras muertas: %d\n", dead_workers);// Imprimir el número de abejas muertas
+    log_printf("    ├─ Abejas nacidas: %d\n", hive->born_bees);// Imprimir el número de abejas nacidas
+    log_printf("    └─ Total de muertes: %d\n", hive->dead_bees);// Imprimir el número de muertes
 }
 
 void print_beehive_stats(ProcessInfo* process_info) {// Imprimir las estadísticas del apiario
     Beehive* hive = process_info->hive;// Obtener la colmena del proceso principal (para acceder a los recursos y a la colmena)
 
-    printf("\nColmena #%d - Estadísticas Generales:\n", hive->id);// Imprimir el mensaje de estadísticas generales
+    log_printf("\nColmena #%d - Estadísticas Generales:\n", hive->id);// Imprimir el mensaje de estadísticas generales
     print_detailed_bee_status(process_info);// Imprimir el estado detallado de las abejas
-    printf("├─ Total de miel: %d/%d\n", hive->honey_count, MAX_HONEY_PER_HIVE);// Imprimir el total de miel
-    printf("├─ Total de huevos: %d/%d\n", hive->egg_count, MAX_EGGS_PER_HIVE);// Imprimir el total de huevos
-    printf("├─ Huevos eclosionados: %d\n", hive->hatched_eggs);// Imprimir el número de huevos eclosionados
-    printf("├─ Abejas muertas: %d\n", hive->dead_bees);// Imprimir el número de abejas muertas
-    printf("├─ Abejas nacidas: %d\n", hive->born_bees);// Imprimir el número de abejas nacidas
-    printf("├─ Miel producida: %d\n", hive->produced_honey);// Imprimir el total de miel producido
-    printf("├─ Polen total recolectado: %d\n", hive->resources.total_polen_collected);// Imprimir el total de polen recolectado
-    printf("└─ Recursos para FSJ (abejas + miel): %d\n", hive->bees_and_honey_count);// Imprimir el total de abejas y miel
+    log_printf("├─ Total de miel: %d/%d\n", hive->honey_count, MAX_HONEY_PER_HIVE);// Imprimir el total de miel
+    log_printf("├─ Total de huevos: %d/%d\n", hive->egg_count, MAX_EGGS_PER_HIVE);// Imprimir el total de huevos
+    log_printf("├─ Huevos eclosionados: %d\n", hive->hatched_eggs);// Imprimir el número de huevos eclosionados
+    log_printf("├─ Abejas muertas: %d\n", hive->dead_bees);// Imprimir el número de abejas muertas
+    log_printf("├─ Abejas nacidas: %d\n", hive->born_bees);// Imprimir el número de abejas nacidas
+    log_printf("├─ Miel producida: %d\n", hive->produced_honey);// Imprimir el total de miel producido
+    log_printf("├─ Polen total recolectado: %d\n", hive->resources.total_polen_collected);// Imprimir el total de polen recolectado
+    log_printf("└─ Recursos para FSJ (abejas + miel): %d\n", hive->bees_and_honey_count);// Imprimir el total de abejas y miel
     print_chamber_matrix(process_info);// Imprimir la matriz de cámaras
 }
 
 bool check_new_queen(ProcessInfo* process_info) {// Comprobar si hay una reina
     Beehive* hive = process_info->hive;// Obtener la colmena del proceso principal (para acceder a los recursos y a la colmena)
     
-    pthread_mutex_lock(&hive->chamber_mutex);// Bloquear el mutex de las cámaras
-    bool needs_new_hive = hive->should_create_new_hive;// Comprobar si se debe crear una nueva colmena
+    bool needs_new_hive = atomic_exchange(&hive->should_create_new_hive, false);// Consumir el aviso de nueva colmena
     if (needs_new_hive) {// Si se debe crear una nueva colmena
-        printf("\nColmena #%d - Nueva reina detectada: Se iniciará una nueva colmena\n", hive->id);// Imprimir el mensaje de nueva reina detectada
-        hive->should_create_new_hive = false;// Liberar el mutex de las cámaras
+        log_printf("\nColmena #%d - Nueva reina detectada: Se iniciará una nueva colmena\n", hive->id);// Imprimir el mensaje de nueva reina detectada
     }
-    pthread_mutex_unlock(&hive->chamber_mutex);// Desbloquear el mutex de las cámaras
     
     return needs_new_hive;// Devolver si se debe crear una nueva colmena
 }
\ No newline at end of file
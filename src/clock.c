@@ -0,0 +1,67 @@
+#include <time.h> // Biblioteca de tiempo
+#include <stdatomic.h> // Biblioteca de operaciones atómicas
+#include "../include/core/clock.h" // Reloj monótono
+
+static bool virtual_enabled = false; // Indica si el tiempo lo marca la cola de eventos
+static _Atomic clock_ns_t virtual_now = CLOCK_VIRTUAL_EPOCH; // Hora virtual actual
+
+// Convierte un timespec a nanosegundos
+static clock_ns_t timespec_to_ns(const struct timespec* ts) {
+    return (clock_ns_t)ts->tv_sec * CLOCK_NS_PER_SEC + ts->tv_nsec; // Segundos y nanosegundos en una sola cifra
+}
+
+clock_ns_t clock_now_ns(void) {
+    if (virtual_enabled) return atomic_load_explicit(&virtual_now, memory_order_acquire); // Hora virtual
+    return clock_wall_now_ns(); // Hora real
+}
+
+clock_ns_t clock_wall_now_ns(void) {
+    struct timespec ts; // Hora actual
+    clock_gettime(CLOCK_MONOTONIC, &ts); // El reloj monótono no salta con ajustes de hora
+    return timespec_to_ns(&ts); // Devuelve la hora en nanosegundos
+}
+
+clock_ns_t clock_coarse_now_ns(void) {
+    if (virtual_enabled) return atomic_load_explicit(&virtual_now, memory_order_acquire); // Hora virtual
+    struct timespec ts; // Hora actual
+    #ifdef CLOCK_MONOTONIC_COARSE // Si el sistema ofrece la variante aproximada
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &ts); // Lee el valor cacheado por el núcleo en el último tick (sin leer el hardware)
+    #else
+        clock_gettime(CLOCK_MONOTONIC, &ts); // Si no, usa el reloj monótono preciso
+    #endif
+    return timespec_to_ns(&ts); // Devuelve la hora en nanosegundos
+}
+
+void clock_use_virtual(bool enabled) {
+    virtual_enabled = enabled; // Cambia la fuente de tiempo
+    atomic_store(&virtual_now, CLOCK_VIRTUAL_EPOCH); // El tiempo virtual empieza en la época
+}
+
+bool clock_is_virtual(void) {
+    return virtual_enabled; // Indica la fuente de tiempo
+}
+
+void clock_advance_to(clock_ns_t t) {
+    if (t > atomic_load_explicit(&virtual_now, memory_order_relaxed)) { // Solo avanza
+        atomic_store_explicit(&virtual_now, t, memory_order_release); // Salta directamente a la marca
+    }
+}
+
+clock_ns_t clock_ms_to_ns(int64_t milliseconds) {
+    return milliseconds * CLOCK_NS_PER_MS; // Convierte milisegundos a nanosegundos
+}
+
+double clock_elapsed_ms(clock_ns_t since, clock_ns_t now) {
+    return (double)(now - since) / CLOCK_NS_PER_MS; // Diferencia en milisegundos con fracción
+}
+
+double clock_elapsed_seconds(clock_ns_t since, clock_ns_t now) {
+    return (double)(now - since) / CLOCK_NS_PER_SEC; // Diferencia en segundos con fracción
+}
+
+struct timespec clock_to_timespec(clock_ns_t t) {
+    struct timespec ts; // Marca convertida
+    ts.tv_sec = (time_t)(t / CLOCK_NS_PER_SEC); // Segundos completos
+    ts.tv_nsec = (long)(t % CLOCK_NS_PER_SEC); // Resto en nanosegundos
+    return ts; // Devuelve la marca convertida
+}
@@ -0,0 +1,170 @@
+#include <stdio.h> // Biblioteca de entrada/salida estándar
+#include <stdlib.h> // Biblioteca de funciones de uso general
+#include <string.h> // Biblioteca de strings
+#include <getopt.h> // Lectura de opciones largas
+#include "../include/core/config.h" // Configuración
+#include "../include/core/policies.h" // Políticas de planificación
+#include "../include/types/beehive_types.h" // Tipos de colmenas
+
+// Opciones largas (las que no tienen forma corta usan valores por encima de 255)
+enum {
+    OPTION_VIRTUAL = 256, // --virtual
+    OPTION_MAX_HIVES, // --max-hives
+    OPTION_QUANTUM_MODE, // --quantum-mode
+    OPTION_METRICS, // --metrics
+    OPTION_REPLAY, // --replay
+    OPTION_EPOCH // --epoch
+};
+
+static const struct option long_options[] = {
+    {"hives", required_argument, NULL, 'n'}, // Colmenas iniciales
+    {"max-hives", required_argument, NULL, OPTION_MAX_HIVES}, // Máximo de colmenas
+    {"duration", required_argument, NULL, 'd'}, // Duración en segundos
+    {"virtual", no_argument, NULL, OPTION_VIRTUAL}, // Tiempo virtual
+    {"epoch", no_argument, NULL, OPTION_EPOCH}, // Modo por épocas
+    {"seed", required_argument, NULL, 's'}, // Semilla maestra
+    {"policy", required_argument, NULL, 'p'}, // Política fija
+    {"quantum-mode", required_argument, NULL, OPTION_QUANTUM_MODE}, // Modo del quantum
+    {"headless", no_argument, NULL, 'q'}, // Sin salida por ciclo
+    {"metrics", required_argument, NULL, OPTION_METRICS}, // Archivo de métricas
+    {"replay", required_argument, NULL, OPTION_REPLAY}, // Reproducir una traza
+    {"help", no_argument, NULL, 'h'}, // Ayuda
+    {NULL, 0, NULL, 0}
+};
+
+// Convertir un entero positivo; devuelve false si el texto no es un número válido
+static bool parse_positive_int(const char* text, int* value) {
+    char* end;// Fin del número
+    long parsed = strtol(text, &end, 10);// Convertir el texto
+    if (*text == '\0' || *end != '\0' || parsed <= 0 || parsed > PROCESS_LIMIT) return false;// Comprobar el rango
+    *value = (int)parsed;// Guardar el valor
+    return true;// Configuración válida
+}
+
+void init_simulation_config(SimulationConfig* config) {
+    memset(config, 0, sizeof(*config));// Todo a cero
+    config->initial_hives = INITIAL_BEEHIVES;// Colmenas iniciales por defecto
+    config->max_hives = MAX_PROCESSES;// Máximo de colmenas por defecto
+    config->policy = ROUND_ROBIN;// Política inicial por defecto
+    config->quantum_mode = QUANTUM_MODE_ADAPTIVE;// El quantum se ajusta con las esperas medidas
+}
+
+void print_usage(const char* program) {
+    printf("Uso: %s [opciones]\n", program);// Línea de uso
+    printf("  -n, --hives N           Colmenas iniciales (por defecto %d)\n", INITIAL_BEEHIVES);// Línea de ayuda
+    printf("      --max-hives N       Máximo de colmenas; la tabla y las colas crecen hasta él (por defecto %d o -n, como máximo %d)\n", MAX_PROCESSES, PROCESS_LIMIT);// Línea de ayuda
+    printf("  -d, --duration S        Segundos a simular (tiempo real: hasta Ctrl+C si se omite; virtual: %.0f)\n", DEFAULT_VIRTUAL_DURATION);// Línea de ayuda
+    printf("      --virtual           Simular en tiempo virtual (el reloj salta de evento en evento)\n");// Línea de ayuda
+    printf("      --epoch             Sin planificador: todas las colmenas avanzan un ciclo por época en paralelo (implica --virtual)\n");// Línea de ayuda
+    printf("  -s, --seed N            Semilla maestra (por defecto la hora actual)\n");// Línea de ayuda
+    printf("  -p, --policy P          Política fija: rr, sjf, mlfq, cfs o wfs (sin alternancia automática)\n");// Línea de ayuda
+    printf("      --quantum-mode M    Quantum: random o adaptive (por defecto adaptive)\n");// Línea de ayuda
+    printf("  -q, --headless          Sin salida por ciclo; imprime un resumen JSON al terminar\n");// Línea de ayuda
+    printf("      --metrics FILE      Escribir el resumen JSON en FILE\n");// Línea de ayuda
+    printf("      --replay FILE       Reproducir una traza grabada (con --policy elige una sola política)\n");// Línea de ayuda
+    printf("  -h, --help              Mostrar esta ayuda\n");// Línea de ayuda
+}
+
+bool parse_command_line(SimulationConfig* config, int argc, char* argv[]) {
+    int option;// Opción actual
+    char* end;// Fin de los números
+    bool max_hives_set = false;// Indica si se fijó el máximo de colmenas
+    optind = 1;// Empezar por el primer argumento
+
+    while ((option = getopt_long(argc, argv, "n:d:s:p:qh", long_options, NULL)) != -1) {// Recorrer las opciones
+        switch (option) {
+            case 'n':// Colmenas iniciales
+                if (!parse_positive_int(optarg, &config->initial_hives)) {
+                    fprintf(stderr, "Número de colmenas no válido: %s (1-%d)\n", optarg, PROCESS_LIMIT);// Imprimir el error
+                    return false;// Configuración no válida
+                }
+                break;// Siguiente opción
+            case OPTION_MAX_HIVES:// Máximo de colmenas
+                if (!parse_positive_int(optarg, &config->max_hives)) {
+                    fprintf(stderr, "Máximo de colmenas no válido: %s (1-%d)\n", optarg, PROCESS_LIMIT);// Imprimir el error
+                    return false;// Configuración no válida
+                }
+                max_hives_set = true;// Guardar la opción
+                break;// Siguiente opción
+            case 'd':// Duración
+                config->duration_seconds = strtod(optarg, &end);// Convertir los segundos
+                if (*optarg == '\0' || *end != '\0' || config->duration_seconds <= 0.0) {
+                    fprintf(stderr, "Duración no válida: %s\n", optarg);// Imprimir el error
+                    return false;// Configuración no válida
+                }
+                break;// Siguiente opción
+            case OPTION_VIRTUAL:// Tiempo virtual
+                config->virtual_time = true;// Guardar la opción
+                break;// Siguiente opción
+            case OPTION_EPOCH:// Modo por épocas
+                config->epoch_mode = true;// Guardar la opción
+                config->virtual_time = true;// Las épocas marcan el tiempo virtual
+                break;// Siguiente opción
+            case 's':// Semilla
+                config->seed = strtoull(optarg, &end, 0);// Convertir la semilla (admite 0x...)
+                if (*optarg == '\0' || *end != '\0') {
+                    fprintf(stderr, "Semilla no válida: %s\n", optarg);// Imprimir el error
+                    return false;// Configuración no válida
+                }
+                config->has_seed = true;// Guardar la opción
+                break;// Siguiente opción
+            case 'p':// Política
+                if (!parse_scheduling_policy(optarg, &config->policy)) {
+                    config->replay_policy = optarg;// "all" solo tiene sentido en la reproducción
+                    if (strcmp(optarg, "all") != 0) {
+                        fprintf(stderr, "Política desconocida: %s (rr, sjf, mlfq, cfs o wfs)\n", optarg);// Imprimir el error
+                        return false;// Configuración no válida
+                    }
+                    break;// Siguiente opción
+                }
+                config->has_policy = true;// Guardar la opción
+                config->replay_policy = optarg;// Guardar la opción
+                break;// Siguiente opción
+            case OPTION_QUANTUM_MODE:// Modo del quantum
+                if (strcmp(optarg, "random") == 0) {
+                    config->quantum_mode = QUANTUM_MODE_RANDOM;// Guardar la opción
+                } else if (strcmp(optarg, "adaptive") == 0) {
+                    config->quantum_mode = QUANTUM_MODE_ADAPTIVE;// Guardar la opción
+                } else {
+                    fprintf(stderr, "Modo de quantum desconocido: %s (random o adaptive)\n", optarg);// Imprimir el error
+                    return false;// Configuración no válida
+                }
+                break;// Siguiente opción
+            case 'q':// Sin salida por ciclo
+                config->headless = true;// Guardar la opción
+                break;// Siguiente opción
+            case OPTION_METRICS:// Archivo de métricas
+                config->metrics_path = optarg;// Guardar la opción
+                break;// Siguiente opción
+            case OPTION_REPLAY:// Reproducción
+                config->replay_path = optarg;// Guardar la opción
+                break;// Siguiente opción
+            case 'h':// Ayuda
+                print_usage(argv[0]);// Imprimir la ayuda
+                exit(0);// Salir sin simular
+            default:// Opción desconocida (getopt ya imprimió el error)
+                print_usage(argv[0]);// Imprimir la ayuda
+                return false;// Configuración no válida
+        }
+    }
+
+    if (optind < argc) {// Argumentos sobrantes
+        fprintf(stderr, "Argumento inesperado: %s\n", argv[optind]);// Imprimir el error
+        return false;// Configuración no válida
+    }
+    if (!max_hives_set && config->initial_hives > config->max_hives) {// Sin máximo explícito, el máximo por defecto cubre las colmenas iniciales
+        config->max_hives = config->initial_hives;// Guardar la opción
+    }
+    if (config->initial_hives > config->max_hives) {// Las colmenas iniciales deben caber
+        fprintf(stderr, "Las colmenas iniciales (%d) superan el máximo (%d)\n", config->initial_hives, config->max_hives);// Imprimir el error
+        return false;// Configuración no válida
+    }
+    if (!config->has_policy && config->replay_policy && !config->replay_path) {// "all" no es una política de simulación
+        fprintf(stderr, "La política all solo es válida con --replay\n");// Imprimir el error
+        return false;// Configuración no válida
+    }
+    if (config->virtual_time && config->duration_seconds <= 0.0) {// En tiempo virtual siempre hay un final
+        config->duration_seconds = DEFAULT_VIRTUAL_DURATION;// Guardar la opción
+    }
+    return true;// Configuración válida
+}
@@ -0,0 +1,34 @@
+#include "../include/core/epoch.h" // Modo por épocas
+#include "../include/core/beehive.h" // Colmena
+#include "../include/core/thread_pool.h" // Pool de trabajadores
+
+// Época que se está ejecutando (solo hay una a la vez: la barrera la cierra antes de abrir la siguiente)
+static EpochStep current_step;
+
+// Tarea de un trabajador: reclama lotes de colmenas hasta que no quedan
+static void epoch_worker(void* arg) {
+    EpochStep* step = (EpochStep*)arg; // Época en curso
+    int begin; // Primera colmena del lote
+    while ((begin = atomic_fetch_add(&step->next, EPOCH_BATCH_HIVES)) < step->count) { // Reclama el siguiente lote
+        int end = begin + EPOCH_BATCH_HIVES < step->count ? begin + EPOCH_BATCH_HIVES : step->count; // Fin del lote
+        for (int i = begin; i < end; i++) { // Recorre el lote
+            run_hive_epoch_tick(step->processes[i]); // Cada colmena solo toca su propio estado
+        }
+    }
+}
+
+int run_epoch(ProcessInfo** processes, int count) {
+    ThreadPool* pool = &scheduler_state.worker_pool; // Pool de trabajadores del planificador
+    current_step.processes = processes; // Tabla de procesos
+    current_step.count = count; // Colmenas de la época
+    atomic_store(&current_step.next, 0); // Ninguna reclamada
+    
+    int batches = (count + EPOCH_BATCH_HIVES - 1) / EPOCH_BATCH_HIVES; // Lotes de la época
+    int tasks = batches < pool->worker_count ? batches : pool->worker_count; // Una tarea por trabajador (sin tareas ociosas)
+    for (int t = 0; t < tasks; t++) { // Encola las tareas
+        thread_pool_submit(pool, epoch_worker, &current_step); // Cada tarea reclama lotes hasta vaciar la época
+    }
+    thread_pool_wait_idle(pool); // Barrera: todas las colmenas terminaron su ciclo
+    
+    return count; // Un ciclo por colmena
+}
@@ -1,5 +1,6 @@
 #include "../include/core/file_manager.h" // Gestión de archivos
 #include "../include/core/utils.h" // Utilidades
+#include "../include/core/clock.h" // Reloj monótono
 #include <stdio.h> // Biblioteca de entrada/salida estándar
 #include <stdlib.h> // Biblioteca de funciones de uso general
 #include <string.h> // Biblioteca de strings
@@ -16,6 +17,11 @@ pthread_mutex_t pcb_mutex = PTHREAD_MUTEX_INITIALIZER; // Mutex para el acceso a
 pthread_mutex_t process_table_mutex = PTHREAD_MUTEX_INITIALIZER; // Mutex para el acceso a la tabla de procesos
 pthread_mutex_t history_mutex = PTHREAD_MUTEX_INITIALIZER; // Mutex para el acceso a la historia de colmenas
 
+// Copia en memoria del archivo de PCB (se lee una sola vez; protegida por pcb_mutex)
+static json_object* pcb_records = NULL; // Array de PCB (NULL hasta el primer uso)
+static int pcb_batch_depth = 0; // Lotes abiertos: mientras haya alguno el archivo no se reescribe
+static bool pcb_dirty = false; // Indica si la copia en memoria tiene cambios sin escribir
+
 static const char* process_state_to_string(ProcessState state); // Convierte el estado de un proceso a una cadena legible
 static json_object* pcb_to_json(ProcessControlBlock* pcb); // Convierte un bloque de control de procesos a un objeto JSON
 static json_object* beehive_to_json(Beehive* hive); // Convierte una colmena a un objeto JSON
@@ -87,6 +93,37 @@ static json_object* beehive_to_json(Beehive* hive) {
     return obj;
 }
 
+// Obtiene el array de PCB en memoria, leyéndolo del archivo la primera vez (requiere pcb_mutex)
+static json_object* load_pcb_records(void) {
+    if (!pcb_records) { // Primer acceso
+        pcb_records = read_json_array_file(PCB_FILE); // Lee el archivo de PCB una sola vez
+    }
+    return pcb_records; // Devuelve el array en memoria
+}
+
+// Vuelca el array de PCB al archivo si cambió, salvo dentro de un lote (requiere pcb_mutex)
+static void flush_pcb_records(void) {
+    if (pcb_batch_depth == 0 && pcb_records && pcb_dirty) { // Fuera de un lote y con cambios
+        write_json_file(PCB_FILE, pcb_records); // Escribe el archivo de PCB
+        pcb_dirty = false; // Archivo al día
+    }
+}
+
+// Abre un lote de altas de PCB: el archivo se escribe una sola vez al cerrarlo
+void begin_pcb_batch(void) {
+    pthread_mutex_lock(&pcb_mutex); // Bloquea el mutex para el acceso a PCB
+    pcb_batch_depth++; // Un lote más abierto
+    pthread_mutex_unlock(&pcb_mutex); // Desbloquea el mutex para el acceso a PCB
+}
+
+// Cierra un lote de altas de PCB y escribe el archivo si era el último
+void end_pcb_batch(void) {
+    pthread_mutex_lock(&pcb_mutex); // Bloquea el mutex para el acceso a PCB
+    if (pcb_batch_depth > 0) pcb_batch_depth--; // Un lote menos abierto
+    flush_pcb_records(); // Escribe todas las altas del lote de una vez
+    pthread_mutex_unlock(&pcb_mutex); // Desbloquea el mutex para el acceso a PCB
+}
+
 // Inicialización del sistema de manejo de archivos
 void init_file_manager(void) {
     if (!directory_exists("data")) { // Si no existe el directorio data, lo crea
@@ -112,6 +149,16 @@ void init_file_manager(void) {
     }
 }
 
+// Escribe los PCB pendientes y libera la copia en memoria
+void cleanup_file_manager(void) {
+    pthread_mutex_lock(&pcb_mutex); // Bloquea el mutex para el acceso a PCB
+    pcb_batch_depth = 0; // Cierra los lotes que quedaran abiertos
+    flush_pcb_records(); // Último volcado
+    json_object_put(pcb_records); // Libera el array de PCB
+    pcb_records = NULL; // Se volvería a leer del archivo
+    pthread_mutex_unlock(&pcb_mutex); // Desbloquea el mutex para el acceso a PCB
+}
+
 //Inicialización de la Tabla de procesos
 void init_process_table(ProcessTable* table) {
     if (!table) return; // Si no hay tabla de procesos, devuelve
@@ -133,6 +180,7 @@ void init_pcb(ProcessControlBlock* pcb, int process_id) {
     
     pcb->process_id = process_id; // ID del proceso
     pcb->arrival_time = time(NULL); // Hora de llegada
+    pcb->arrival_clock = clock_now_ns(); // Momento monótono de llegada
     pcb->iterations = 0; // Número de iteraciones
     pcb->avg_io_wait_time = 0.0; // Tiempo promedio en espera de E/S
     pcb->avg_ready_wait_time = 0.0; // Tiempo promedio en cola de listos
@@ -140,8 +188,8 @@ void init_pcb(ProcessControlBlock* pcb, int process_id) {
     pcb->total_io_waits = 0; // Número total de operaciones E/S
     pcb->total_io_wait_time = 0.0; // Tiempo total en espera de E/S
     pcb->total_ready_wait_time = 0.0; // Tiempo total en cola de listos
-    pcb->last_ready_time = time(NULL); // Hora de última vez que entró en cola de listos
-    pcb->last_state_change = time(NULL); // Hora de última vez que cambió de estado
+    pcb->last_ready_time = pcb->arrival_clock; // Hora de última vez que entró en cola de listos
+    pcb->last_state_change = pcb->arrival_clock; // Hora de última vez que cambió de estado
 }
 
 // Crea un bloque de control de procesos (PCB) para una colmena específica
@@ -151,8 +199,8 @@ void create_pcb_for_beehive(ProcessInfo* process_info) {
     pthread_mutex_lock(&pcb_mutex); // Bloquea el mutex para el acceso a PCB
     init_pcb(process_info->pcb, process_info->hive->id); // Inicializa el bloque de control de procesos
     
-    // Lee el archivo de PCB
-    json_object* array = read_json_array_file(PCB_FILE);
+    // Array de PCB en memoria (no se vuelve a leer el archivo por cada colmena)
+    json_object* array = load_pcb_records();
     
     // Convierte el PCB a JSON y lo añade al array
     json_object* pcb_obj = pcb_to_json(process_info->pcb);
@@ -160,9 +208,9 @@ void create_pcb_for_beehive(ProcessInfo* process_info) {
         json_object_array_add(array, pcb_obj); // Añade el objeto JSON al array
     }
     
-    // Guarda el archivo actualizado
-    write_json_file(PCB_FILE, array);
-    json_object_put(array); // Libera el array de objetos JSON
+    // Guarda el archivo actualizado (dentro de un lote, al cerrarlo)
+    pcb_dirty = true; // Alta pendiente de escribir
+    flush_pcb_records();
     
     pthread_mutex_unlock(&pcb_mutex); // Desbloquea el mutex para el acceso a PCB
 }
@@ -171,8 +219,8 @@ void create_pcb_for_beehive(ProcessInfo* process_info) {
 void update_pcb_state(ProcessControlBlock* pcb, ProcessState new_state, Beehive* hive) {
     if (!pcb || !hive) return; // Si no hay bloque de control de procesos o colmena, devuelve
     
-    time_t current_time = time(NULL); // Obtiene la hora actual
-    double elapsed_time = difftime(current_time, pcb->last_state_change); // Tiempo transcurrido desde la última vez que cambió de estado
+    clock_ns_t current_time = clock_now_ns(); // Obtiene la hora actual
+    double elapsed_time = clock_elapsed_seconds(pcb->last_state_change, current_time); // Tiempo transcurrido desde la última vez que cambió de estado
     
     switch (pcb->state) { // Convierte el estado actual del proceso a una cadena legible
         case READY: // Proceso listo
@@ -196,6 +244,10 @@ void update_pcb_state(ProcessControlBlock* pcb, ProcessState new_state, Beehive*
             break;
     }
     
+    if (new_state == READY && pcb->state != READY) { // Si entra en la cola de listos
+        pcb->last_ready_time = current_time; // Guarda el momento de entrada en ready
+    }
+    
     if (new_state == WAITING && pcb->state != WAITING) { // Si el nuevo estado es WAITING y el actual no lo es
         pcb->total_io_waits++; // Incrementa el número de operaciones E/S
     }
@@ -216,7 +268,7 @@ void save_pcb(ProcessControlBlock* pcb) {
     if (!pcb) return; // Si no hay bloque de control de procesos, devuelve
     
     pthread_mutex_lock(&pcb_mutex); // Bloquea el mutex para el acceso a PCB
-    json_object* array = read_json_array_file(PCB_FILE); // Lee el archivo de PCB
+    json_object* array = load_pcb_records(); // Array de PCB en memoria
     json_object* pcb_obj = pcb_to_json(pcb); // Convierte el bloque de control de procesos a JSON
     
     // Busca y actualiza el bloque de control de procesos existente
@@ -238,8 +290,8 @@ void save_pcb(ProcessControlBlock* pcb) {
         json_object_array_add(array, pcb_obj); // Añade el bloque de control de procesos a la lista
     }
     
-    write_json_file(PCB_FILE, array); // Escribe el archivo de PCB actualizado
-    json_object_put(array); // Libera el array de objetos JSON
+    pcb_dirty = true; // Cambio pendiente de escribir
+    flush_pcb_records(); // Escribe el archivo de PCB actualizado
     pthread_mutex_unlock(&pcb_mutex); // Desbloquea el mutex para el acceso a PCB
 }
 
@@ -289,7 +341,7 @@ void update_process_table(ProcessControlBlock* pcb) {
     double old_weight = (double)(table->total_processes) / (table->total_processes + 1); // Tiempo promedio de llegada a cola
     double new_weight = 1.0 / (table->total_processes + 1); // Tiempo promedio de iteraciones
 
-    table->avg_arrival_time = (table->avg_arrival_time * old_weight) + (difftime(time(NULL), pcb->arrival_time) * new_weight); // Tiempo promedio de llegada a cola
+    table->avg_arrival_time = (table->avg_arrival_time * old_weight) + (clock_elapsed_seconds(pcb->arrival_clock, clock_now_ns()) * new_weight); // Tiempo promedio de llegada a cola
     table->avg_iterations = (table->avg_iterations * old_weight) + (pcb->iterations * new_weight); // Tiempo promedio de iteraciones
     table->avg_io_wait_time = (table->avg_io_wait_time * old_weight) + (pcb->avg_io_wait_time * new_weight); // Tiempo promedio en espera de E/S
     table->avg_ready_wait_time = (table->avg_ready_wait_time * old_weight) + (pcb->avg_ready_wait_time * new_weight); // Tiempo promedio en cola de listos
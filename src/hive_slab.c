@@ -0,0 +1,76 @@
+#include <stdlib.h> // Biblioteca de funciones de uso general
+#include <string.h> // Biblioteca de strings
+#include <stddef.h> // offsetof
+#include "../include/core/hive_slab.h" // Asignador de colmenas
+
+// Instancia del asignador (las colmenas se crean y destruyen desde el hilo que conduce la simulación, el mutex cubre el resto)
+static HiveSlabAllocator allocator = { .mutex = PTHREAD_MUTEX_INITIALIZER };
+
+_Static_assert(sizeof(HiveSlab) % HIVE_BLOCK_ALIGN == 0, "aligned_alloc necesita un tamaño múltiplo de la alineación");// Comprobar el tamaño del slab
+
+// Recupera el bloque a partir de su proceso
+static HiveBlock* hive_block_of(ProcessInfo* process) {
+    return (HiveBlock*)((char*)process - offsetof(HiveBlock, process)); // El proceso está dentro del bloque
+}
+
+// Reserva un slab nuevo y encadena sus bloques en la lista libre (requiere el mutex)
+static bool hive_slab_grow(void) {
+    HiveSlab* slab = aligned_alloc(HIVE_BLOCK_ALIGN, sizeof(HiveSlab)); // Una sola reserva alineada para todos los bloques
+    if (!slab) return false; // Sin memoria
+    
+    for (int i = HIVE_SLAB_BLOCKS - 1; i >= 0; i--) { // En orden inverso: los bloques salen en orden de dirección
+        slab->blocks[i].next_free = allocator.free_list; // Enlaza el bloque
+        allocator.free_list = &slab->blocks[i]; // Nueva cabeza de la lista
+    }
+    slab->next = allocator.slabs; // Encadena el slab
+    allocator.slabs = slab; // Nuevo primer slab
+    return true; // Slab reservado
+}
+
+ProcessInfo* hive_slab_alloc(void) {
+    pthread_mutex_lock(&allocator.mutex); // Bloquea la lista libre
+    if (!allocator.free_list && !hive_slab_grow()) { // Sin bloques libres ni memoria para otro slab
+        pthread_mutex_unlock(&allocator.mutex); // Desbloquea la lista libre
+        return NULL; // Sin memoria
+    }
+    HiveBlock* block = allocator.free_list; // Primer bloque libre (el último devuelto, aún caliente en caché)
+    allocator.free_list = block->next_free; // Lo saca de la lista
+    pthread_mutex_unlock(&allocator.mutex); // Desbloquea la lista libre
+    
+    block->next_free = NULL; // Bloque en uso
+    memset(&block->process, 0, sizeof(ProcessInfo)); // Proceso a cero (la colmena, el PCB y el semáforo los inicializa quien los usa)
+    return &block->process; // Devuelve el proceso del bloque
+}
+
+void hive_slab_free(ProcessInfo* process) {
+    if (!process) return; // Nada que devolver
+    HiveBlock* block = hive_block_of(process); // Bloque del proceso
+    
+    pthread_mutex_lock(&allocator.mutex); // Bloquea la lista libre
+    block->next_free = allocator.free_list; // Enlaza el bloque
+    allocator.free_list = block; // Se reutiliza en la próxima reserva
+    pthread_mutex_unlock(&allocator.mutex); // Desbloquea la lista libre
+}
+
+void cleanup_hive_slabs(void) {
+    pthread_mutex_lock(&allocator.mutex); // Bloquea la lista libre
+    while (allocator.slabs) { // Recorre los slabs
+        HiveSlab* next = allocator.slabs->next; // Siguiente slab
+        free(allocator.slabs); // Libera el slab con todos sus bloques
+        allocator.slabs = next; // Continúa con el siguiente
+    }
+    allocator.free_list = NULL; // Sin bloques libres
+    pthread_mutex_unlock(&allocator.mutex); // Desbloquea la lista libre
+}
+
+Beehive* hive_slab_hive(ProcessInfo* process) {
+    return &hive_block_of(process)->hive; // Colmena del bloque
+}
+
+ProcessControlBlock* hive_slab_pcb(ProcessInfo* process) {
+    return &hive_block_of(process)->pcb; // PCB del bloque
+}
+
+sem_t* hive_slab_sem(ProcessInfo* process) {
+    return &hive_block_of(process)->shared_resource_sem; // Semáforo del bloque
+}
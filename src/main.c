@@ -10,23 +10,29 @@
 #include "../include/core/scheduler.h" // Planificador
 #include "../include/core/file_manager.h" // Gestión de archivos
 #include "../include/core/utils.h" // Utilidades
+#include "../include/core/clock.h" // Reloj monótono
+#include "../include/core/trace.h" // Traza binaria
+#include "../include/core/replay.h" // Reproducción de trazas
+#include "../include/core/rng.h" // Generador de números aleatorios
+#include "../include/core/sim.h" // Simulación en tiempo virtual
+#include "../include/core/config.h" // Línea de comandos
+#include "../include/core/epoch.h" // Modo por épocas
+#include "../include/core/hive_slab.h" // Asignador de colmenas
 
 // Variables globales
 static volatile sig_atomic_t running = 1;// Indicador de que el programa está en ejecución
-static ProcessInfo processes[MAX_PROCESSES];// Tabla de procesos (para almacenar la información de cada proceso)
+static ProcessInfo** processes = NULL;// Tabla de procesos (crece bajo demanda hasta config.max_hives; cada entrada tiene dirección fija)
+static int process_capacity = 0;// Entradas reservadas en la tabla
+static SimulationConfig config;// Configuración de la ejecución
+static long long epochs_run = 0;// Épocas completadas (modo por épocas)
+static long long epoch_hive_ticks = 0;// Ciclos de colmena ejecutados en las épocas
+static int epoch_workers = 0;// Trabajadores del pool que ejecutaron las épocas (el pool ya está cerrado al escribir las métricas)
 
 // Manejo de señales
 static void handle_signal(int sig) {// Manejar la señal de terminación
     (void)sig;// Ignorar el parámetro
-    printf("\nRecibida señal de terminación (Ctrl+C). Finalizando el programa...\n");// Imprimir mensaje de terminación
-    running = 0;// Indicar que el programa está en ejecución
-
-    // Detener todos los procesos
-    for (int i = 0; i < scheduler_state.process_table->total_processes; i++) {// Recorrer todas las colmenas
-        if (processes[i].hive != NULL) {// Comprobar si la colmena está inicializada
-            processes[i].hive->should_terminate = 1;// Indicar que se debe detener el hilo del proceso
-        }
-    }
+    log_printf("\nRecibida señal de terminación (Ctrl+C). Finalizando el programa...\n");// Imprimir mensaje de terminación
+    running = 0;// Indicar que el programa está en ejecución (las colmenas se detienen en cleanup_processes: la tabla puede estar creciendo)
 }
 
 static void setup_signal_handlers(void) {// Configurar los manejadores de señales
@@ -42,160 +48,411 @@ static void setup_signal_handlers(void) {// Configurar los manejadores de señal
 }
 
 // Gestión de procesos
-static void init_processes(void) {// Inicializar los procesos
-    memset(processes, 0, sizeof(processes));// Inicializar la tabla de procesos
+static ProcessInfo* allocate_process(int index) {// Reservar la entrada de un proceso nuevo (NULL si se alcanzó el máximo o falta memoria)
+    if (index >= config.max_hives) return NULL;// Máximo de colmenas alcanzado
+    if (index >= process_capacity) {// La tabla está llena
+        int capacity = process_capacity < QUEUE_INITIAL_CAPACITY ? QUEUE_INITIAL_CAPACITY : process_capacity * 2;// Duplicar la tabla
+        if (capacity > config.max_hives) capacity = config.max_hives;// Sin superar el máximo de colmenas
+        ProcessInfo** table = realloc(processes, capacity * sizeof(ProcessInfo*));// Ampliar la tabla (solo se mueven los punteros)
+        if (!table) return NULL;// Sin memoria
+        memset(table + process_capacity, 0, (capacity - process_capacity) * sizeof(ProcessInfo*));// Entradas nuevas vacías
+        processes = table;// Nueva tabla
+        process_capacity = capacity;// Nueva capacidad
+    }
+    ProcessInfo* process = hive_slab_alloc();// Bloque de la colmena a cero (las colas guardan la dirección del proceso)
+    if (!process) return NULL;// Sin memoria
+    process->index = index;// Asignar el índice del proceso
+    processes[index] = process;// Guardar en la tabla
+    return process;// Devolver el proceso
+}
 
-    for (int i = 0; i < INITIAL_BEEHIVES; i++) {// Recorrer todas las colmenas iniciales
-        ProcessInfo* process = &processes[i];// Obtener la información del proceso
-        process->index = i;// Asignar el índice del proceso
-        init_process_semaphores(process);// Inicializar los semáforos del proceso
-        init_beehive_process(process, i);// Inicializar el proceso
-        add_to_ready_queue(process);// Añadir el proceso a la cola de listos
+static void init_processes(void) {// Inicializar los procesos
+    scheduler_state.process_table->total_processes = 0;// Tabla vacía
+    begin_pcb_batch();// Las altas de las colmenas iniciales se escriben de una vez
+    for (int i = 0; i < config.initial_hives; i++) {// Recorrer todas las colmenas iniciales
+        ProcessInfo* process = allocate_process(i);// Obtener la información del proceso
+        if (!process) {// Sin memoria para la colmena
+            fprintf(stderr, "No se pudo reservar la colmena %d\n", i);// Imprimir el error
+            exit(1);// Salir del programa
+        }
+        scheduler_state.process_table->total_processes++;// Incrementar el número de procesos
+        init_beehive_process(process, i);// Inicializar el proceso (y sus semáforos)
+        trace_event(TRACE_SPAWN, process->index, 0, 0, process->hive->bees_and_honey_count);// Registrar el nacimiento en la traza
+        if (!config.epoch_mode) publish_ready_process(process);// Publicar el proceso para que el planificador lo encole (las épocas recorren la tabla)
     }
+    end_pcb_batch();// Escribir el archivo de PCB
 }
 
 static void cleanup_processes(void) {// Limpiar los procesos
-    printf("\nLimpiando todos los procesos...\n");// Imprimir mensaje de limpieza
+    log_printf("\nLimpiando todos los procesos...\n");// Imprimir mensaje de limpieza
     for (int i = 0; i < scheduler_state.process_table->total_processes; i++) {// Recorrer todas las colmenas
-        if (processes[i].hive != NULL) {// Comprobar si la colmena está inicializada
-            printf("├─ Limpiando proceso #%d...\n", i);// Imprimir mensaje de limpieza
-            cleanup_beehive_process(&processes[i]);// Limpiar el proceso
-            cleanup_process_semaphores(&processes[i]);// Limpiar los semáforos del proceso
+        if (processes[i] != NULL && processes[i]->hive != NULL) {// Comprobar si la colmena está inicializada
+            log_printf("├─ Limpiando proceso #%d...\n", i);// Imprimir mensaje de limpieza
+            cleanup_beehive_process(processes[i]);// Limpiar el proceso
+            cleanup_process_semaphores(processes[i]);// Limpiar los semáforos del proceso
         }
+        hive_slab_free(processes[i]);// Devolver el bloque de la colmena a la lista libre
+        processes[i] = NULL;// Entrada vacía
     }
+    free(processes);// Liberar la tabla
+    processes = NULL;// Sin tabla
+    process_capacity = 0;// Sin capacidad
 }
 
 static void handle_new_process(ProcessInfo* process_info) {// Manejar nuevas colmenas
-    if (check_new_queen(process_info) && scheduler_state.process_table->total_processes < MAX_PROCESSES) {// Comprobar si hay una reina y si se puede crear una nueva colmena
-        int new_index = -1;// Inicializar el índice de la colmena
-        
-        // Buscar siguiente índice disponible
-        for (int i = 0; i < MAX_PROCESSES; i++) {// Recorrer todas las colmenas
-            if (processes[i].hive == NULL) {// Comprobar si la colmena está vacía
-                new_index = i;// Asignar el índice de la colmena
-                break;// Salir del bucle
-            }
-        }
+    if (check_new_queen(process_info)) {// Comprobar si hay una reina
+        int new_index = scheduler_state.process_table->total_processes;// Las colmenas no se destruyen durante la simulación: el siguiente índice libre es el total
+        ProcessInfo* new_process = allocate_process(new_index);// Reservar la entrada (NULL si no se puede crear una nueva colmena)
 
-        if (new_index != -1) {// Comprobar si se ha encontrado un índice disponible
-            ProcessInfo* new_process = &processes[new_index];// Obtener la información del proceso
-            new_process->index = new_index;// Asignar el índice del proceso
-            init_process_semaphores(new_process);// Inicializar los semáforos del proceso
-            init_beehive_process(new_process, new_index);// Inicializar el proceso
-            add_to_ready_queue(new_process);// Añadir el proceso a la cola de listos
+        if (!new_process) {// Máximo de colmenas alcanzado
+            atomic_fetch_add(&scheduler_state.spawn_overflows, 1);// Contar la colmena descartada
+            log_printf("- Máximo de colmenas alcanzado (%d): nueva colmena descartada\n", config.max_hives);// Imprimir el descarte
+        } else {// Se puede crear una nueva colmena
+            init_beehive_process(new_process, new_index);// Inicializar el proceso (y sus semáforos)
+            trace_event(TRACE_SPAWN, new_process->index, 0, 0, new_process->hive->bees_and_honey_count);// Registrar el nacimiento en la traza
+            if (!config.epoch_mode) publish_ready_process(new_process);// Publicar la colmena nueva sin bloquear al planificador
             scheduler_state.process_table->total_processes++;// Incrementar el número de procesos
-            printf("- Total de procesos activos: %d/%d\n\n", scheduler_state.process_table->total_processes, MAX_PROCESSES);// Imprimir el número de procesos activos
+            log_printf("- Total de procesos activos: %d/%d\n\n", scheduler_state.process_table->total_processes, config.max_hives);// Imprimir el número de procesos activos
         }
     }
 }
 
-static void print_ready_queue() {// Imprimir la cola de listos
-    printf("\nProcesos en cola de listos: %d\n", scheduler_state.ready_queue->size);// Imprimir el número de procesos en cola de listos
+static void print_ready_queue(DispatchSlot* slot) {// Imprimir la cola de listos de un núcleo
+    ReadyQueue* queue = slot->ready_queue;// Obtener la cola local del núcleo
+    pthread_mutex_lock(&queue->mutex);// Bloquear la cola mientras se recorre (otros núcleos pueden modificarla)
+    int size = atomic_load_explicit(&queue->size, memory_order_relaxed);// Tamaño de la cola de listos
+    log_printf("\nProcesos en cola de listos del núcleo #%d: %d\n", slot->id, size);// Imprimir el número de procesos en cola de listos
     
-    if(scheduler_state.ready_queue->size == 0) {// Comprobar si la cola de listos está vacía
-        printf("└─ No hay procesos en cola de listos\n");// Imprimir que no hay procesos en cola de listos
+    if(size == 0) {// Comprobar si la cola de listos está vacía
+        log_printf("└─ No hay procesos en cola de listos\n");// Imprimir que no hay procesos en cola de listos
+        pthread_mutex_unlock(&queue->mutex);// Desbloquear la cola
         return;// Salir del bucle
     }
 
-    for (int i = 0; i < scheduler_state.ready_queue->size - 1; i++) {// Recorrer todas las entradas de la cola de listos
-        ProcessInfo* process = scheduler_state.ready_queue->processes[i];// Obtener la información del proceso actual (para calcular la posición vacía)
-        printf("├─ Proceso #%d: %d abejas, %d miel, %d recursos\n", process->index, process->hive->bee_count, process->hive->honey_count, process->hive->bees_and_honey_count);// Imprimir el mensaje de la cola de listos
+    for (int i = 0; i < size - 1; i++) {// Recorrer todas las entradas de la cola de listos
+        ProcessInfo* process = queue->processes[i];// Obtener la información del proceso actual (para calcular la posición vacía)
+        log_printf("├─ Proceso #%d: %d abejas, %d miel, %d recursos\n", process->index, process->hive->bee_count, process->hive->honey_count, process->hive->bees_and_honey_count);// Imprimir el mensaje de la cola de listos
     }
 
-    ProcessInfo* process = scheduler_state.ready_queue->processes[scheduler_state.ready_queue->size - 1];// Obtener la información del último proceso en la cola de listos
-    printf("└─ Proceso #%d: %d abejas, %d miel, %d recursos\n", process->index, process->hive->bee_count, process->hive->honey_count, process->hive->bees_and_honey_count);// Imprimir el mensaje del último proceso en la cola de listos
+    ProcessInfo* process = queue->processes[size - 1];// Obtener la información del último proceso en la cola de listos
+    log_printf("└─ Proceso #%d: %d abejas, %d miel, %d recursos\n", process->index, process->hive->bee_count, process->hive->honey_count, process->hive->bees_and_honey_count);// Imprimir el mensaje del último proceso en la cola de listos
+    pthread_mutex_unlock(&queue->mutex);// Desbloquear la cola
 }
 
 static void print_io_queue() {// Imprimir la cola de E/S
-    printf("\nProcesos en cola de E/S: %d\n", scheduler_state.io_queue->size);// Imprimir el número de procesos en cola de E/S
+    log_printf("\nProcesos en cola de E/S: %d\n", scheduler_state.io_queue->size);// Imprimir el número de procesos en cola de E/S
     
     if(scheduler_state.io_queue->size == 0) {// Comprobar si la cola de E/S está vacía
-        printf("└─ No hay procesos en cola de E/S\n");// Imprimir que no hay procesos en cola de E/S
+        log_printf("└─ No hay procesos en cola de E/S\n");// Imprimir que no hay procesos en cola de E/S
         return;// Salir del bucle
     }
 
     for (int i = 0; i < scheduler_state.io_queue->size - 1; i++) {// Recorrer todas las entradas de la cola de E/S
         ProcessInfo* process = scheduler_state.io_queue->entries[i].process;// Obtener la información del proceso actual (para calcular la posición vacía)
-        printf("├─ Proceso #%d: %d abejas, %d miel, %d recursos\n", process->index, process->hive->bee_count, process->hive->honey_count, process->hive->bees_and_honey_count);// Imprimir el mensaje de la cola de E/S
+        log_printf("├─ Proceso #%d: %d abejas, %d miel, %d recursos\n", process->index, process->hive->bee_count, process->hive->honey_count, process->hive->bees_and_honey_count);// Imprimir el mensaje de la cola de E/S
     }
 
     ProcessInfo* process = scheduler_state.io_queue->entries[scheduler_state.io_queue->size - 1].process;// Obtener la información del último proceso en la cola de E/S
-    printf("└─ Proceso #%d: %d abejas, %d miel, %d recursos\n", process->index, process->hive->bee_count, process->hive->honey_count, process->hive->bees_and_honey_count);// Imprimir el mensaje del último proceso en la cola de E/S
+    log_printf("└─ Proceso #%d: %d abejas, %d miel, %d recursos\n", process->index, process->hive->bee_count, process->hive->honey_count, process->hive->bees_and_honey_count);// Imprimir el mensaje del último proceso en la cola de E/S
 }
 
 // Impresión de información
 static void print_scheduler_stats(void) {// Imprimir el estado del planificador
-    printf("\n=========== Estado del Planificador ===========\n");// Imprimir el mensaje de estado del planificador
-    printf("Política actual: %s\n", scheduler_state.current_policy == ROUND_ROBIN ? "Round Robin" : "Shortest Job First (FSJ)");// Imprimir la política actual del planificador
+    log_printf("\n=========== Estado del Planificador ===========\n");// Imprimir el mensaje de estado del planificador
+    log_printf("Política actual: %s\n", scheduler_state.policy->name);// Imprimir la política actual del planificador
+
+    if (scheduler_state.policy->uses_quantum) {// Comprobar si la política actual usa quantum
+        log_printf("Quantum actual: %d ms\n", scheduler_state.current_quantum);// Imprimir el quantum actual del planificador
+    }
 
-    if (scheduler_state.current_policy == ROUND_ROBIN) {// Comprobar si la política actual es Round Robin
-        printf("Quantum actual: %d segundos\n", scheduler_state.current_quantum);// Imprimir el quantum actual del planificador
+    QuantumController* controller = &scheduler_state.controller;// Obtener el controlador del quantum
+    if (controller->mode == QUANTUM_MODE_ADAPTIVE && controller->has_samples) {// Comprobar si el controlador ya tiene medidas
+        log_printf("Controlador adaptativo: espera en listos %.0f ms, espera de E/S %.0f ms, expulsiones %.0f%%, %.2f despachos/s\n", controller->ready_wait_ms, controller->io_wait_ms, controller->switch_ratio * 100.0, controller->context_switch_rate);// Imprimir las medidas del controlador
     }
 
-    printf("\nProceso en ejecución: %d\n", scheduler_state.active_process->index);// Imprimir el índice del proceso en ejecución
-    print_ready_queue();// Imprimir la cola de listos
+    for (int i = 0; i < scheduler_state.slot_count; i++) {// Recorrer todos los núcleos
+        DispatchSlot* slot = &scheduler_state.slots[i];// Obtener el núcleo actual
+        if (slot->active_process) {// Comprobar si el núcleo tiene un proceso activo
+            log_printf("\nNúcleo #%d - Proceso en ejecución: %d\n", slot->id, slot->active_process->index);// Imprimir el índice del proceso en ejecución
+        } else {// Si el núcleo está libre
+            log_printf("\nNúcleo #%d - Sin proceso en ejecución\n", slot->id);// Imprimir que el núcleo está libre
+        }
+        print_ready_queue(slot);// Imprimir la cola de listos del núcleo
+    }
     print_io_queue();// Imprimir la cola de E/S
-    printf("===============================================\n");// Imprimir un salto de línea
+    log_printf("\nLatencia de despacho: media %.3f ms, máxima %.3f ms (%d despachos)\n", average_dispatch_latency_ms(), (double)atomic_load(&scheduler_state.dispatch_latency_max_ns) / CLOCK_NS_PER_MS, atomic_load(&scheduler_state.dispatch_count));// Imprimir la latencia de despacho
+    log_printf("===============================================\n");// Imprimir un salto de línea
 }
 
 static void print_initial_state(void) {// Imprimir el estado inicial
-    printf("\n=== Simulación de Colmenas Iniciada ===\n");// Imprimir el mensaje de inicio de simulación
-    printf("├─ Colmenas iniciales: %d\n", INITIAL_BEEHIVES);// Imprimir el número de colmenas iniciales
-    printf("├─ Máximo de colmenas: %d\n", MAX_PROCESSES);// Imprimir el número máximo de colmenas
-    printf("├─ Política inicial: %s\n", scheduler_state.current_policy == ROUND_ROBIN ? "Round Robin" : "FSJ");// Imprimir la política inicial
-    printf("├─ Quantum inicial: %d segundos\n", scheduler_state.current_quantum);// Imprimir el quantum inicial
-    printf("└─ Presione Ctrl+C para finalizar\n\n");// Imprimir un salto de línea
+    log_printf("\n=== Simulación de Colmenas Iniciada ===\n");// Imprimir el mensaje de inicio de simulación
+    log_printf("├─ Colmenas iniciales: %d\n", config.initial_hives);// Imprimir el número de colmenas iniciales
+    log_printf("├─ Máximo de colmenas: %d\n", config.max_hives);// Imprimir el número máximo de colmenas
+    log_printf("├─ Núcleos de despacho: %d\n", scheduler_state.slot_count);// Imprimir el número de núcleos de despacho
+    log_printf("├─ Política inicial: %s\n", scheduler_state.policy->name);// Imprimir la política inicial
+    log_printf("├─ Quantum inicial: %d ms\n", scheduler_state.current_quantum);// Imprimir el quantum inicial
+    log_printf("├─ Semilla: %llu\n", (unsigned long long)rng_master_seed());// Imprimir la semilla maestra (para repetir la ejecución)
+    log_printf("└─ Presione Ctrl+C para finalizar\n\n");// Imprimir un salto de línea
+}
+
+// Un ciclo de la simulación: nuevas colmenas y archivos de estado de los procesos activos
+static void simulation_tick(void) {
+    for (int i = 0; i < scheduler_state.slot_count; i++) {// Recorrer todos los núcleos
+        ProcessInfo* active = scheduler_state.slots[i].active_process;// Obtener el proceso activo del núcleo
+        if (!active) continue;// Comprobar si hay un proceso activo
+
+        // Verificar nuevas colmenas
+        handle_new_process(active);// Manejar la creación de nuevas colmenas
+
+        // Actualizar archivos de estado
+        update_process_table(active->pcb);// Actualizar el estado del PCB del proceso activo
+    }
 }
 
 // Ciclo principal
-static void run_simulation(void) {
-    time_t last_stats_time = time(NULL);// Obtener la hora actual (para calcular el tiempo de actualización de estadísticas)
+static void run_simulation(double seconds) {
+    clock_ns_t start = clock_now_ns();// Inicio de la simulación
+    clock_ns_t last_stats_time = start;// Obtener la hora actual (para calcular el tiempo de actualización de estadísticas)
 
     while (running) {// Mientras no se ha detenido el programa
-        time_t current_time = time(NULL);// Obtener la hora actual (para calcular el tiempo de actualización de estadísticas)
+        clock_ns_t current_time = clock_now_ns();// Obtener la hora actual (para calcular el tiempo de actualización de estadísticas)
+        if (seconds > 0.0 && clock_elapsed_seconds(start, current_time) >= seconds) break;// Fin de la duración pedida
 
         // Imprimir estadísticas cada 5 segundos
-        if (difftime(current_time, last_stats_time) >= 5.0) {// Comprobar si se han pasado 5 segundos desde la última actualización de estadísticas
-            print_scheduler_stats();// Imprimir el estado del planificador
+        if (clock_elapsed_seconds(last_stats_time, current_time) >= STATS_INTERVAL) {// Comprobar si se han pasado 5 segundos desde la última actualización de estadísticas
+            if (!quiet_output) print_scheduler_stats();// Imprimir el estado del planificador
             last_stats_time = current_time;// Actualizar la hora de la última actualización de estadísticas
         }
 
-        // Verificar nuevas colmenas
-        if (scheduler_state.active_process) {// Comprobar si hay un proceso activo
-            handle_new_process(scheduler_state.active_process);// Manejar la creación de nuevas colmenas
+        simulation_tick();// Nuevas colmenas y archivos de estado
+
+        // Esperar antes del siguiente ciclo
+        delay_ms(SIMULATION_TICK_MS);// Retrasar el programa por un número de milisegundos
+    }
+}
+
+// Acciones de la cola de eventos (tiempo virtual)
+static void simulation_tick_event(void* arg) {// Ciclo de la simulación
+    (void)arg;// Ignorar el parámetro
+    simulation_tick();// Nuevas colmenas y archivos de estado
+}
+
+static void stats_event(void* arg) {// Impresión periódica de estadísticas
+    (void)arg;// Ignorar el parámetro
+    if (quiet_output) return;// Sin estadísticas periódicas en modo headless
+    print_scheduler_stats();// Imprimir el estado del planificador
+}
+
+// Ciclo principal en tiempo virtual: el tiempo salta de evento en evento
+static void run_virtual_simulation(double seconds) {
+    clock_ns_t start = clock_now_ns();// Inicio del tiempo virtual
+    clock_ns_t wall_start = clock_wall_now_ns();// Inicio del tiempo real
+
+    sim_schedule_periodic(start + clock_ms_to_ns(SIMULATION_TICK_MS), clock_ms_to_ns(SIMULATION_TICK_MS), simulation_tick_event, NULL);// Un ciclo de simulación por segundo virtual
+    sim_schedule_periodic(start + STATS_INTERVAL * CLOCK_NS_PER_SEC, STATS_INTERVAL * CLOCK_NS_PER_SEC, stats_event, NULL);// Estadísticas cada 5 segundos virtuales
+    long long events = sim_run_until(start + (clock_ns_t)(seconds * CLOCK_NS_PER_SEC), &running);// Ejecutar los eventos hasta el final
+
+    double virtual_seconds = clock_elapsed_seconds(start, clock_now_ns());// Tiempo virtual simulado
+    double wall_seconds = clock_elapsed_seconds(wall_start, clock_wall_now_ns());// Tiempo real empleado
+    log_printf("\nTiempo virtual: %.1f s simulados en %.3f s reales (%.0fx, %lld eventos)\n", virtual_seconds, wall_seconds, wall_seconds > 0.0 ? virtual_seconds / wall_seconds : 0.0, events);// Imprimir la aceleración
+}
+
+// Estadísticas agregadas de todas las colmenas en la barrera de una época
+static void print_epoch_stats(void) {
+    int total = scheduler_state.process_table->total_processes;// Colmenas existentes
+    long long bees = 0, honey = 0, eggs = 0;// Totales de las colmenas
+    for (int i = 0; i < total; i++) {// Recorrer todas las colmenas
+        Beehive* hive = processes[i]->hive;// Colmena del proceso
+        bees += hive->bee_count;// Sumar las abejas
+        honey += hive->honey_count;// Sumar la miel
+        eggs += hive->egg_count;// Sumar los huevos
+    }
+    log_printf("\n=========== Época %lld ===========\n", epochs_run);// Imprimir el número de época
+    log_printf("Colmenas: %d/%d, abejas: %lld, miel: %lld, huevos: %lld\n", total, config.max_hives, bees, honey, eggs);// Imprimir los totales
+    log_printf("Ciclos de colmena: %lld en %d trabajadores\n", epoch_hive_ticks, scheduler_state.worker_pool.worker_count);// Imprimir el trabajo realizado
+    log_printf("=================================\n");// Imprimir el cierre
+}
+
+// Ciclo principal por épocas: cada época todas las colmenas avanzan un ciclo en paralelo y, tras la barrera, se aplican los efectos entre colmenas
+static void run_epoch_simulation(double seconds) {
+    clock_ns_t start = clock_now_ns();// Inicio del tiempo virtual
+    clock_ns_t wall_start = clock_wall_now_ns();// Inicio del tiempo real
+    clock_ns_t period = clock_ms_to_ns(SIMULATION_TICK_MS);// Duración de una época
+    long long epochs = (long long)(seconds * CLOCK_NS_PER_SEC) / period;// Épocas a simular
+    long long stats_every = (long long)STATS_INTERVAL * CLOCK_NS_PER_SEC / period;// Épocas entre estadísticas
+    epoch_workers = scheduler_state.worker_pool.worker_count;// Trabajadores disponibles para las épocas
+
+    while (running && epochs_run < epochs) {// Mientras queden épocas
+        clock_advance_to(start + epochs_run * period);// Hora de la época (fija mientras trabajan las colmenas)
+        int total = scheduler_state.process_table->total_processes;// Colmenas que avanzan en esta época
+        epoch_hive_ticks += run_epoch(processes, total);// Un ciclo por colmena en paralelo, hasta la barrera
+
+        // Barrera: nuevas reinas en orden de colmena (el resultado no depende del número de trabajadores)
+        begin_pcb_batch();// Las altas de la época se escriben de una vez
+        for (int i = 0; i < total; i++) {// Recorrer las colmenas de la época
+            handle_new_process(processes[i]);// Crear la colmena nueva si nació una reina
         }
+        end_pcb_batch();// Escribir el archivo de PCB
+        epochs_run++;// Época completada
 
-        // Actualizar archivos de estado
-        if (scheduler_state.active_process) {// Comprobar si hay un proceso activo
-            update_process_table(scheduler_state.active_process->pcb);// Actualizar el estado del PCB del proceso activo
+        if (!quiet_output && stats_every > 0 && epochs_run % stats_every == 0) {// Estadísticas cada 5 segundos virtuales
+            print_epoch_stats();// Imprimir los totales de la época
         }
+    }
+    clock_advance_to(start + epochs_run * period);// Fin de la última época
 
-        // Esperar antes del siguiente ciclo
-        delay_ms(1000);// Retrasar el programa por un número de milisegundos
+    double virtual_seconds = clock_elapsed_seconds(start, clock_now_ns());// Tiempo virtual simulado
+    double wall_seconds = clock_elapsed_seconds(wall_start, clock_wall_now_ns());// Tiempo real empleado
+    log_printf("\nÉpocas: %lld (%.1f s simulados) en %.3f s reales (%.0f ciclos de colmena/s)\n", epochs_run, virtual_seconds, wall_seconds, wall_seconds > 0.0 ? epoch_hive_ticks / wall_seconds : 0.0);// Imprimir el rendimiento
+}
+
+// Resumen final de métricas (JSON legible por máquina)
+static void write_metrics_summary(double simulated_seconds, double wall_seconds) {
+    int final_hives = 0, bees = 0, honey = 0, eggs = 0, hatched_eggs = 0, born_bees = 0, dead_bees = 0, produced_honey = 0;// Totales de las colmenas
+    long long polen = 0, iterations = 0, io_waits = 0;// Totales de polen, despachos y operaciones de E/S
+    double ready_wait = 0.0, io_wait = 0.0;// Esperas acumuladas (segundos)
+
+    for (int i = 0; i < scheduler_state.process_table->total_processes; i++) {// Recorrer todas las colmenas
+        ProcessInfo* process = processes[i];// Obtener la información del proceso
+        if (process == NULL || process->hive == NULL) continue;// Comprobar si la colmena existe
+        Beehive* hive = process->hive;// Colmena del proceso
+        final_hives++;// Contar la colmena
+        bees += hive->bee_count;// Sumar las abejas
+        honey += hive->honey_count;// Sumar la miel
+        eggs += hive->egg_count;// Sumar los huevos
+        hatched_eggs += hive->hatched_eggs;// Sumar los huevos eclosionados
+        born_bees += hive->born_bees;// Sumar las abejas nacidas
+        dead_bees += hive->dead_bees;// Sumar las abejas muertas
+        produced_honey += hive->produced_honey;// Sumar la miel producida
+        polen += hive->resources.total_polen_collected;// Sumar el polen recolectado
+        if (process->pcb) {// Comprobar si el proceso tiene PCB
+            iterations += process->pcb->iterations;// Sumar los despachos
+            io_waits += process->pcb->total_io_waits;// Sumar las operaciones de E/S
+            ready_wait += process->pcb->total_ready_wait_time;// Sumar la espera en listos
+            io_wait += process->pcb->total_io_wait_time;// Sumar la espera de E/S
+        }
+    }
+
+    json_object* metrics = json_object_new_object();// Objeto raíz
+    json_object_object_add(metrics, "seed", json_object_new_int64((int64_t)rng_master_seed()));// Semilla maestra
+    if (!config.epoch_mode) {// Las épocas no usan política ni quantum
+        json_object_object_add(metrics, "policy", json_object_new_string(scheduler_state.policy->short_name));// Política al terminar
+        json_object_object_add(metrics, "auto_switch_policy", json_object_new_boolean(scheduler_state.auto_switch_policy));// Alternancia automática
+        json_object_object_add(metrics, "quantum_mode", json_object_new_string(scheduler_state.controller.mode == QUANTUM_MODE_ADAPTIVE ? "adaptive" : "random"));// Modo del quantum
+        json_object_object_add(metrics, "final_quantum_ms", json_object_new_int(scheduler_state.current_quantum));// Quantum al terminar
+    }
+    json_object_object_add(metrics, "virtual_time", json_object_new_boolean(config.virtual_time));// Tiempo virtual o real
+    json_object_object_add(metrics, "execution_mode", json_object_new_string(config.epoch_mode ? "epoch" : "scheduler"));// Por épocas o con planificador
+    json_object_object_add(metrics, "simulated_seconds", json_object_new_double(simulated_seconds));// Tiempo simulado
+    json_object_object_add(metrics, "wall_seconds", json_object_new_double(wall_seconds));// Tiempo real empleado
+    json_object_object_add(metrics, "initial_hives", json_object_new_int(config.initial_hives));// Colmenas iniciales
+    json_object_object_add(metrics, "max_hives", json_object_new_int(config.max_hives));// Máximo de colmenas
+    json_object_object_add(metrics, "final_hives", json_object_new_int(final_hives));// Colmenas al terminar
+
+    if (!config.epoch_mode) {// Métricas del planificador (las épocas no despachan: serían todas cero)
+        json_object_object_add(metrics, "dispatch_slots", json_object_new_int(scheduler_state.slot_count));// Núcleos de despacho
+        json_object* scheduler = json_object_new_object();// Métricas del planificador
+        int measured = atomic_load(&scheduler_state.dispatch_count);// Ciclos de colmena ejecutados
+        json_object_object_add(scheduler, "dispatches", json_object_new_int64(iterations));// Entradas en ejecución
+        json_object_object_add(scheduler, "hive_ticks", json_object_new_int(measured));// Ciclos de colmena ejecutados
+        json_object_object_add(scheduler, "preemptions", json_object_new_int(atomic_load(&scheduler_state.preemption_count)));// Expulsiones
+        json_object_object_add(scheduler, "io_operations", json_object_new_int64(io_waits));// Operaciones de E/S
+        json_object_object_add(scheduler, "avg_ready_wait_ms", json_object_new_double(iterations > 0 ? ready_wait * 1000.0 / iterations : 0.0));// Espera media en listos por despacho
+        json_object_object_add(scheduler, "avg_io_wait_ms", json_object_new_double(io_waits > 0 ? io_wait * 1000.0 / io_waits : 0.0));// Espera media por operación de E/S
+        json_object_object_add(scheduler, "avg_dispatch_latency_ms", json_object_new_double(average_dispatch_latency_ms()));// Latencia media de despacho
+        json_object_object_add(scheduler, "max_dispatch_latency_ms", json_object_new_double((double)atomic_load(&scheduler_state.dispatch_latency_max_ns) / CLOCK_NS_PER_MS));// Latencia máxima de despacho
+        json_object_object_add(scheduler, "hive_ticks_per_wall_second", json_object_new_double(wall_seconds > 0.0 ? measured / wall_seconds : 0.0));// Rendimiento
+        json_object* overflows = json_object_new_object();// Desbordamientos de la tabla y las colas (nunca se descartan en silencio)
+        json_object_object_add(overflows, "ready_queue", json_object_new_int(atomic_load(&scheduler_state.ready_overflows)));// Procesos que no cupieron en listos
+        json_object_object_add(overflows, "io_queue", json_object_new_int(atomic_load(&scheduler_state.io_overflows)));// E/S que no cupieron
+        json_object_object_add(overflows, "hive_spawns", json_object_new_int(atomic_load(&scheduler_state.spawn_overflows)));// Colmenas descartadas por el máximo
+        json_object_object_add(scheduler, "overflows", overflows);// Añadir los desbordamientos
+        json_object_object_add(metrics, "scheduler", scheduler);// Añadir las métricas del planificador
+    } else {// Métricas del modo por épocas
+        json_object* epoch = json_object_new_object();// Métricas de las épocas
+        json_object_object_add(epoch, "epochs", json_object_new_int64(epochs_run));// Épocas completadas
+        json_object_object_add(epoch, "workers", json_object_new_int(epoch_workers));// Trabajadores del pool
+        json_object_object_add(epoch, "hive_ticks", json_object_new_int64(epoch_hive_ticks));// Ciclos de colmena ejecutados
+        json_object_object_add(epoch, "hive_ticks_per_wall_second", json_object_new_double(wall_seconds > 0.0 ? epoch_hive_ticks / wall_seconds : 0.0));// Rendimiento
+        json_object_object_add(epoch, "hive_spawn_overflows", json_object_new_int(atomic_load(&scheduler_state.spawn_overflows)));// Colmenas descartadas por el máximo
+        json_object_object_add(metrics, "epoch", epoch);// Añadir las métricas de las épocas
+    }
+
+    json_object* hives = json_object_new_object();// Totales de las colmenas
+    json_object_object_add(hives, "bees", json_object_new_int(bees));// Abejas vivas
+    json_object_object_add(hives, "honey", json_object_new_int(honey));// Miel almacenada
+    json_object_object_add(hives, "eggs", json_object_new_int(eggs));// Huevos sin eclosionar
+    json_object_object_add(hives, "hatched_eggs", json_object_new_int(hatched_eggs));// Huevos eclosionados
+    json_object_object_add(hives, "born_bees", json_object_new_int(born_bees));// Abejas nacidas
+    json_object_object_add(hives, "dead_bees", json_object_new_int(dead_bees));// Abejas muertas
+    json_object_object_add(hives, "produced_honey", json_object_new_int(produced_honey));// Miel producida
+    json_object_object_add(hives, "polen_collected", json_object_new_int64(polen));// Polen recolectado
+    json_object_object_add(metrics, "hives", hives);// Añadir los totales de las colmenas
+
+    if (config.metrics_path) {// Comprobar si se pidió un archivo
+        write_json_file(config.metrics_path, metrics);// Escribir el resumen en el archivo
+    } else {// Salida estándar
+        printf("%s\n", json_object_to_json_string_ext(metrics, JSON_C_TO_STRING_PRETTY));// Imprimir el resumen
     }
+    json_object_put(metrics);// Liberar el objeto
 }
 
-int main(void) {
+int main(int argc, char* argv[]) {
+    init_simulation_config(&config);// Valores por defecto
+    if (!parse_command_line(&config, argc, argv)) {// Leer la línea de comandos
+        return 1;// Configuración no válida
+    }
+    if (config.replay_path) {// Reproducir una traza grabada en lugar de simular
+        return run_trace_replay(config.replay_path, config.replay_policy);// Traza y política opcional (rr, sjf, mlfq, cfs, wfs o all)
+    }
+    quiet_output = config.headless;// Sin salida por ciclo en modo headless
+    if (config.virtual_time) {// Simular en tiempo virtual
+        clock_use_virtual(true);// El reloj lo marca la cola de eventos
+        init_sim_events();// Inicializar la cola global de eventos
+    }
+
     // Configuración inicial
-    srand(time(NULL));// Inicializar el generador de números aleatorios
+    rng_set_master_seed(config.has_seed ? config.seed : (uint64_t)time(NULL));// Semilla maestra de todos los flujos aleatorios
     setup_signal_handlers();// Configurar los manejadores de señales
     
     // Inicializar componentes
     init_file_manager();// Inicializar el gestor de archivos
-    init_scheduler();// Inicializar el planificador
+    init_scheduler(config.policy, !config.has_policy, config.quantum_mode, config.max_hives);// Inicializar el planificador (una política fija no se alterna)
     init_processes();// Inicializar los procesos
     
     // Ejecutar simulación
     print_initial_state();// Imprimir el estado inicial
-    run_simulation();// Ejecutar la simulación
+    clock_ns_t start = clock_now_ns();// Inicio del tiempo simulado
+    clock_ns_t wall_start = clock_wall_now_ns();// Inicio del tiempo real
+    if (config.epoch_mode) {// Todas las colmenas a la vez, sin planificador (su evento periódico nunca se ejecuta)
+        run_epoch_simulation(config.duration_seconds);// Ejecutar la simulación época a época
+    } else if (clock_is_virtual()) {// Comprobar si se simula en tiempo virtual
+        run_virtual_simulation(config.duration_seconds);// Ejecutar la simulación saltando de evento en evento
+    } else {// Tiempo real
+        run_simulation(config.duration_seconds);// Ejecutar la simulación
+    }
+    double simulated_seconds = clock_elapsed_seconds(start, clock_now_ns());// Tiempo simulado
+    double wall_seconds = clock_elapsed_seconds(wall_start, clock_wall_now_ns());// Tiempo real empleado
+    
+    stop_scheduler();// Ningún hilo del planificador ni ciclo del pool vuelve a tocar los procesos
+    if (config.headless || config.metrics_path) {// Comprobar si se pidió el resumen de métricas
+        write_metrics_summary(simulated_seconds, wall_seconds);// Resumen de la simulación detenida, antes de liberar las colmenas
+    }
     
     // Limpieza
+    int total_processes = scheduler_state.process_table->total_processes;// Total antes de liberar la tabla
     cleanup_processes();// Limpiar los procesos y sus recursos (PCB y colmenas)
     cleanup_scheduler();// Limpiar el planificador y sus recursos (colas de listos y E/S)
+    cleanup_hive_slabs();// Liberar los bloques de las colmenas (ya no queda ningún hilo ni cola que los apunte)
+    cleanup_file_manager();// Liberar la copia en memoria de los PCB
+    
+    if (clock_is_virtual()) {// Comprobar si se simuló en tiempo virtual
+        cleanup_sim_events();// Liberar la cola de eventos
+    }
     
-    printf("\n=== Simulación Finalizada ===\n");// Imprimir el mensaje de finalización de simulación
-    printf("Total de procesos: %d\n", scheduler_state.process_table->total_processes);// Imprimir el número de procesos iniciales
-    printf("Recursos liberados correctamente\n\n");// Imprimir un salto de línea
+    log_printf("\n=== Simulación Finalizada ===\n");// Imprimir el mensaje de finalización de simulación
+    log_printf("Total de procesos: %d\n", total_processes);// Imprimir el número de procesos iniciales
+    log_printf("Recursos liberados correctamente\n\n");// Imprimir un salto de línea
     
     return 0;
-}
\ No newline at end of file
+}
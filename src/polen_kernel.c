@@ -0,0 +1,92 @@
+#include <pthread.h> // Biblioteca de hilos
+#include "../include/core/polen_kernel.h" // Núcleo de recolección de polen
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h> // Intrínsecos SSE2 y AVX2
+#define POLEN_KERNEL_X86 1 // Hay núcleos vectoriales
+#endif
+
+typedef int (*PolenKernelFn)(int32_t*, const int32_t*, const int32_t*, int, BeeSet*);// Firma común de los núcleos
+
+static PolenKernelFn polen_kernel;// Núcleo elegido
+static const char* polen_kernel_label;// Nombre del núcleo elegido
+static pthread_once_t polen_kernel_once = PTHREAD_ONCE_INIT;// Se elige una sola vez
+
+// Versión escalar (referencia y CPUs sin SIMD)
+static int collect_polen_scalar(int32_t* polen_collected, const int32_t* draws, const int32_t* lifetime, int count, BeeSet* reached) {
+    int total = 0;// Polen total
+    BeeSet mask = 0;// Abejas que alcanzaron su límite
+    for (int i = 0; i < count; i++) {// Recorrer los carriles
+        polen_collected[i] += draws[i];// Acumular el polen
+        total += draws[i];// Sumar al total
+        mask |= (BeeSet)(polen_collected[i] >= lifetime[i]) << i;// Marcar si alcanzó su límite
+    }
+    *reached = mask;// Devolver las abejas que alcanzaron su límite
+    return total;// Devolver el total
+}
+
+#ifdef POLEN_KERNEL_X86
+// SSE2: 4 carriles por iteración (disponible en toda CPU x86-64)
+__attribute__((target("sse2")))
+static int collect_polen_sse2(int32_t* polen_collected, const int32_t* draws, const int32_t* lifetime, int count, BeeSet* reached) {
+    __m128i sum = _mm_setzero_si128();// Sumas parciales por carril
+    BeeSet mask = 0;// Abejas que alcanzaron su límite
+    for (int i = 0; i < count; i += 4) {// Recorrer de 4 en 4
+        __m128i draw = _mm_loadu_si128((const __m128i*)(draws + i));// Polen de esta pasada
+        __m128i polen = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(polen_collected + i)), draw);// Polen acumulado
+        _mm_storeu_si128((__m128i*)(polen_collected + i), polen);// Guardar el polen acumulado
+        sum = _mm_add_epi32(sum, draw);// Acumular el total
+        __m128i below = _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)(lifetime + i)), polen);// Carriles que aún no alcanzan su límite
+        mask |= (BeeSet)(~_mm_movemask_ps(_mm_castsi128_ps(below)) & 0xF) << i;// El resto alcanzó su límite
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));// Reducir 4 → 2
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));// Reducir 2 → 1
+    *reached = mask;// Devolver las abejas que alcanzaron su límite
+    return _mm_cvtsi128_si32(sum);// Devolver el total
+}
+
+// AVX2: 8 carriles por iteración
+__attribute__((target("avx2")))
+static int collect_polen_avx2(int32_t* polen_collected, const int32_t* draws, const int32_t* lifetime, int count, BeeSet* reached) {
+    __m256i sum = _mm256_setzero_si256();// Sumas parciales por carril
+    BeeSet mask = 0;// Abejas que alcanzaron su límite
+    for (int i = 0; i < count; i += 8) {// Recorrer de 8 en 8
+        __m256i draw = _mm256_loadu_si256((const __m256i*)(draws + i));// Polen de esta pasada
+        __m256i polen = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(polen_collected + i)), draw);// Polen acumulado
+        _mm256_storeu_si256((__m256i*)(polen_collected + i), polen);// Guardar el polen acumulado
+        sum = _mm256_add_epi32(sum, draw);// Acumular el total
+        __m256i below = _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i*)(lifetime + i)), polen);// Carriles que aún no alcanzan su límite
+        mask |= (BeeSet)(~_mm256_movemask_ps(_mm256_castsi256_ps(below)) & 0xFF) << i;// El resto alcanzó su límite
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));// Reducir 8 → 4
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));// Reducir 4 → 2
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));// Reducir 2 → 1
+    *reached = mask;// Devolver las abejas que alcanzaron su límite
+    return _mm_cvtsi128_si32(half);// Devolver el total
+}
+#endif
+
+static void select_polen_kernel(void) {// Elegir el mejor núcleo que soporta la CPU
+    polen_kernel = collect_polen_scalar;// Por defecto el escalar
+    polen_kernel_label = "scalar";// Nombre del núcleo
+#ifdef POLEN_KERNEL_X86
+    __builtin_cpu_init();// Leer las capacidades de la CPU
+    if (__builtin_cpu_supports("avx2")) {// Comprobar AVX2
+        polen_kernel = collect_polen_avx2;// 8 carriles
+        polen_kernel_label = "avx2";// Nombre del núcleo
+    } else if (__builtin_cpu_supports("sse2")) {// Comprobar SSE2
+        polen_kernel = collect_polen_sse2;// 4 carriles
+        polen_kernel_label = "sse2";// Nombre del núcleo
+    }
+#endif
+}
+
+int collect_polen(int32_t* polen_collected, const int32_t* draws, const int32_t* lifetime, int count, BeeSet* reached) {
+    pthread_once(&polen_kernel_once, select_polen_kernel);// Elegir el núcleo la primera vez
+    return polen_kernel(polen_collected, draws, lifetime, count, reached);// Ejecutar el núcleo
+}
+
+const char* polen_kernel_name(void) {
+    pthread_once(&polen_kernel_once, select_polen_kernel);// Elegir el núcleo la primera vez
+    return polen_kernel_label;// Nombre del núcleo
+}
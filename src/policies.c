@@ -0,0 +1,165 @@
+#include <string.h> // Biblioteca de strings
+#include "../include/core/policies.h" // Políticas de planificación
+#include "../include/core/scheduler.h" // Planificador
+#include "../include/core/clock.h" // Reloj monótono
+
+// Desempate común: orden de llegada a la cola
+static bool arrived_before(const ProcessInfo* a, const ProcessInfo* b) {
+    return a->ready_sequence < b->ready_sequence; // Primero el que llegó antes
+}
+
+// Enganche vacío para políticas que no ajustan nada al encolar
+static void enqueue_noop(ReadyQueue* queue, ProcessInfo* process, clock_ns_t now) {
+    (void)queue; // Sin uso
+    (void)process; // Sin uso
+    (void)now; // Sin uso
+}
+
+// Enganche vacío para políticas sin envejecimiento en la cola
+static bool age_noop(ProcessInfo* queued, clock_ns_t now) {
+    (void)queued; // Sin uso
+    (void)now; // Sin uso
+    return false; // La prioridad no cambia
+}
+
+// Round Robin: FIFO con quantum
+static bool rr_precedes(const ProcessInfo* a, const ProcessInfo* b) {
+    return arrived_before(a, b); // Orden de llegada
+}
+
+static bool rr_tick(ProcessInfo* current, clock_ns_t ran_ns, clock_ns_t slice_ns, const ProcessInfo* next) {
+    (void)current; // Sin uso
+    (void)ran_ns; // Sin uso
+    (void)next; // Sin uso
+    return slice_ns >= clock_ms_to_ns(scheduler_state.current_quantum); // Cede el núcleo al agotar el quantum
+}
+
+static bool rr_preempt_check(const ProcessInfo* candidate, const ProcessInfo* current) {
+    (void)candidate; // Sin uso
+    (void)current; // Sin uso
+    return false; // RR solo expulsa por quantum
+}
+
+// Shortest Job First: la colmena más pequeña primero, con expulsión
+static bool sjf_precedes(const ProcessInfo* a, const ProcessInfo* b) {
+    if (a->hive->bees_and_honey_count != b->hive->bees_and_honey_count) { // Manda el tamaño de la colmena
+        return a->hive->bees_and_honey_count < b->hive->bees_and_honey_count; // Primero la colmena más pequeña
+    }
+    return arrived_before(a, b); // En empate se respeta el orden de llegada
+}
+
+static bool sjf_tick(ProcessInfo* current, clock_ns_t ran_ns, clock_ns_t slice_ns, const ProcessInfo* next) {
+    (void)current; // Sin uso
+    (void)ran_ns; // Sin uso
+    (void)slice_ns; // Sin uso
+    (void)next; // Sin uso
+    return false; // SJF no tiene quantum
+}
+
+static bool sjf_preempt_check(const ProcessInfo* candidate, const ProcessInfo* current) {
+    return candidate->hive->bees_and_honey_count < current->hive->bees_and_honey_count; // El nuevo proceso es menor que la colmena actual
+}
+
+// Cola multinivel con retroalimentación: se baja de nivel al agotar el quantum del nivel
+static clock_ns_t mlfq_level_quantum(int level) {
+    return clock_ms_to_ns((int64_t)MLFQ_BASE_QUANTUM << level); // El quantum se duplica en cada nivel
+}
+
+static bool mlfq_precedes(const ProcessInfo* a, const ProcessInfo* b) {
+    if (a->mlfq_level != b->mlfq_level) return a->mlfq_level < b->mlfq_level; // Primero el nivel más prioritario
+    return arrived_before(a, b); // Dentro del nivel, FIFO
+}
+
+static bool mlfq_boost(ProcessInfo* process, clock_ns_t now) {// Devuelve al nivel superior un proceso que lleva demasiado tiempo en un nivel inferior
+    if (process->mlfq_level == 0 || now - process->mlfq_level_since < MLFQ_BOOST_INTERVAL * CLOCK_NS_PER_SEC) return false; // Sin inanición
+    process->mlfq_level = 0; // Vuelve al nivel superior (evita la inanición)
+    process->mlfq_level_since = now; // Reinicia el tiempo en el nivel
+    return true; // Prioridad cambiada
+}
+
+static void mlfq_enqueue(ReadyQueue* queue, ProcessInfo* process, clock_ns_t now) {
+    (void)queue; // Sin uso
+    if (process->mlfq_level_since == 0) { // Primera vez en la cola multinivel
+        process->mlfq_level_since = now; // Empieza en el nivel superior
+    } else {
+        mlfq_boost(process, now); // Al volver a la cola
+    }
+}
+
+static bool mlfq_age(ProcessInfo* queued, clock_ns_t now) {
+    return mlfq_boost(queued, now); // También mientras espera en la cola (nadie lo reencola)
+}
+
+static bool mlfq_tick(ProcessInfo* current, clock_ns_t ran_ns, clock_ns_t slice_ns, const ProcessInfo* next) {
+    (void)next; // Sin uso
+    if (slice_ns < mlfq_level_quantum(current->mlfq_level)) return false; // Aún le queda quantum en su nivel
+    if (current->mlfq_level < MLFQ_LEVELS - 1) { // Si no está en el último nivel
+        current->mlfq_level++; // Baja un nivel por consumir el quantum completo
+        current->mlfq_level_since = current->last_account_time + ran_ns; // Reinicia el tiempo en el nivel (fin del tramo contabilizado)
+    }
+    return true; // Cede el núcleo
+}
+
+static bool mlfq_preempt_check(const ProcessInfo* candidate, const ProcessInfo* current) {
+    return candidate->mlfq_level < current->mlfq_level; // Un nivel más prioritario desplaza al activo
+}
+
+// Reparto justo por tiempo virtual (estilo CFS): el menor vruntime primero
+static bool fair_precedes(const ProcessInfo* a, const ProcessInfo* b) {
+    if (a->vruntime != b->vruntime) return a->vruntime < b->vruntime; // Primero el que menos CPU virtual ha recibido
+    return arrived_before(a, b); // En empate, orden de llegada
+}
+
+static void fair_enqueue(ReadyQueue* queue, ProcessInfo* process, clock_ns_t now) {
+    (void)now; // Sin uso
+    if (process->vruntime < queue->min_vruntime) { // Si llega desde E/S o es nuevo
+        process->vruntime = queue->min_vruntime; // No acumula crédito mientras no competía
+    }
+}
+
+static bool fair_should_yield(const ProcessInfo* current, clock_ns_t slice_ns, const ProcessInfo* next) {
+    if (!next || slice_ns < clock_ms_to_ns(CFS_MIN_GRANULARITY)) return false; // Sin competencia o sin tiempo mínimo cumplido
+    return next->vruntime < current->vruntime; // Cede si otro ha recibido menos CPU virtual
+}
+
+static bool cfs_tick(ProcessInfo* current, clock_ns_t ran_ns, clock_ns_t slice_ns, const ProcessInfo* next) {
+    current->vruntime += ran_ns; // El tiempo virtual avanza al ritmo real
+    return fair_should_yield(current, slice_ns, next); // Decide si cede el núcleo
+}
+
+static bool fair_preempt_check(const ProcessInfo* candidate, const ProcessInfo* current) {
+    return candidate->vruntime + clock_ms_to_ns(CFS_WAKEUP_GRANULARITY) < current->vruntime; // Solo con ventaja suficiente
+}
+
+// Reparto ponderado: las colmenas grandes acumulan tiempo virtual más despacio
+static bool wfs_tick(ProcessInfo* current, clock_ns_t ran_ns, clock_ns_t slice_ns, const ProcessInfo* next) {
+    int weight = current->hive->bees_and_honey_count; // Peso de la colmena (abejas + miel)
+    if (weight < 1) weight = 1; // Peso mínimo
+    current->vruntime += ran_ns * WFS_REFERENCE_WEIGHT / weight; // Avance inversamente proporcional al peso
+    return fair_should_yield(current, slice_ns, next); // Decide si cede el núcleo
+}
+
+// Registro de políticas (mismo orden que SchedulingPolicy)
+static const SchedulerPolicyOps policy_table[POLICY_COUNT] = {
+    { ROUND_ROBIN, "Round Robin", "rr", true, rr_precedes, enqueue_noop, rr_tick, rr_preempt_check, age_noop },
+    { SHORTEST_JOB_FIRST, "Shortest Job First (FSJ)", "sjf", false, sjf_precedes, enqueue_noop, sjf_tick, sjf_preempt_check, age_noop },
+    { MULTILEVEL_FEEDBACK, "Multinivel con retroalimentación (MLFQ)", "mlfq", false, mlfq_precedes, mlfq_enqueue, mlfq_tick, mlfq_preempt_check, mlfq_age },
+    { COMPLETELY_FAIR, "Reparto justo (CFS)", "cfs", false, fair_precedes, fair_enqueue, cfs_tick, fair_preempt_check, age_noop },
+    { WEIGHTED_FAIR_SHARE, "Reparto ponderado por tamaño (WFS)", "wfs", false, fair_precedes, fair_enqueue, wfs_tick, fair_preempt_check, age_noop },
+};
+
+const SchedulerPolicyOps* get_policy_ops(SchedulingPolicy policy) {
+    if (policy < 0 || policy >= POLICY_COUNT) return &policy_table[ROUND_ROBIN]; // Política desconocida: Round Robin
+    return &policy_table[policy]; // Devuelve las operaciones de la política
+}
+
+bool parse_scheduling_policy(const char* name, SchedulingPolicy* policy) {
+    if (!name || !policy) return false; // Sin nombre no hay política
+    for (int i = 0; i < POLICY_COUNT; i++) { // Recorre el registro
+        if (strcmp(name, policy_table[i].short_name) == 0) { // Coincide el nombre corto
+            *policy = policy_table[i].id; // Devuelve la política
+            return true; // Encontrada
+        }
+    }
+    return false; // No existe
+}
@@ -0,0 +1,86 @@
+#include <string.h> // Biblioteca de strings
+#include "../include/core/quantum_controller.h" // Controlador adaptativo de quantum
+#include "../include/core/clock.h" // Reloj monótono
+
+// Media móvil exponencial: la primera medida se toma tal cual
+static double smooth(double average, double sample, bool has_average) {
+    if (!has_average) return sample; // Sin historial, la muestra es la media
+    return average + CONTROLLER_SMOOTHING * (sample - average); // Acerca la media a la muestra
+}
+
+void init_quantum_controller(QuantumController* controller, QuantumMode mode, clock_ns_t now) {
+    memset(controller, 0, sizeof(QuantumController)); // Sin medidas ni medias
+    controller->mode = mode; // Modo de ajuste
+    controller->window_start = now; // Empieza la primera ventana
+}
+
+void quantum_controller_record(QuantumController* controller, ProcessState old_state, ProcessState new_state, double ready_wait_seconds, double io_wait_seconds) {
+    if (old_state == READY && new_state == RUNNING) { // Despacho: termina una espera en cola de listos
+        atomic_fetch_add(&controller->window_dispatches, 1); // Cuenta el despacho
+        atomic_fetch_add(&controller->window_ready_wait_ns, (long long)(ready_wait_seconds * CLOCK_NS_PER_SEC)); // Acumula la espera que sumó el PCB
+    } else if (old_state == WAITING && new_state == READY) { // Fin de E/S
+        atomic_fetch_add(&controller->window_io_completions, 1); // Cuenta el fin de E/S
+        atomic_fetch_add(&controller->window_io_wait_ns, (long long)(io_wait_seconds * CLOCK_NS_PER_SEC)); // Acumula la espera de E/S que sumó el PCB
+    }
+    
+    if (old_state == RUNNING && new_state != RUNNING) { // Termina una ráfaga de CPU
+        atomic_fetch_add(&controller->window_bursts, 1); // Cuenta la ráfaga
+        if (new_state == READY) { // Vuelve a listos sin pedir E/S: la cortó la política
+            atomic_fetch_add(&controller->window_preemptions, 1); // Cuenta el cambio de contexto involuntario
+        }
+    }
+}
+
+bool quantum_controller_sample(QuantumController* controller, SchedulingPolicy policy, clock_ns_t now) {
+    double window_seconds = clock_elapsed_seconds(controller->window_start, now); // Duración de la ventana actual
+    if (window_seconds < CONTROLLER_SAMPLE_INTERVAL) return false; // La ventana aún no vence
+    
+    int dispatches = atomic_exchange(&controller->window_dispatches, 0); // Cierra la ventana de despachos
+    int bursts = atomic_exchange(&controller->window_bursts, 0); // Cierra la ventana de ráfagas
+    int preemptions = atomic_exchange(&controller->window_preemptions, 0); // Cierra la ventana de expulsiones
+    int io_completions = atomic_exchange(&controller->window_io_completions, 0); // Cierra la ventana de E/S
+    long long ready_wait_ns = atomic_exchange(&controller->window_ready_wait_ns, 0); // Espera en listos de la ventana
+    long long io_wait_ns = atomic_exchange(&controller->window_io_wait_ns, 0); // Espera de E/S de la ventana
+    controller->window_start = now; // Empieza la siguiente ventana
+    
+    if (dispatches == 0) return false; // Sin despachos no hay nada que medir
+    
+    double ready_wait_ms = (double)ready_wait_ns / dispatches / CLOCK_NS_PER_MS; // Espera media por despacho
+    double switch_ratio = bursts > 0 ? (double)preemptions / bursts : 0.0; // Fracción de ráfagas cortadas
+    double io_ratio = (double)io_completions / dispatches; // Fines de E/S por despacho
+    bool has = controller->has_samples; // Indica si hay medias previas
+    
+    controller->ready_wait_ms = smooth(controller->ready_wait_ms, ready_wait_ms, has); // Actualiza la espera en listos
+    if (io_completions > 0) { // Solo hay espera de E/S si hubo fines de E/S
+        controller->io_wait_ms = smooth(controller->io_wait_ms, (double)io_wait_ns / io_completions / CLOCK_NS_PER_MS, has && controller->io_wait_ms > 0.0); // Actualiza la espera de E/S
+    }
+    controller->switch_ratio = smooth(controller->switch_ratio, switch_ratio, has); // Actualiza la fracción de expulsiones
+    controller->io_ratio = smooth(controller->io_ratio, io_ratio, has); // Actualiza la proporción de E/S
+    controller->context_switch_rate = smooth(controller->context_switch_rate, dispatches / window_seconds, has); // Actualiza la tasa de cambios de contexto
+    controller->policy_ready_wait_ms[policy] = smooth(controller->policy_ready_wait_ms[policy], ready_wait_ms, controller->policy_measured[policy]); // Puntuación de la política medida
+    controller->policy_measured[policy] = true; // La política ya tiene medidas
+    controller->has_samples = true; // Ya hay medias
+    return true; // Hay una muestra nueva
+}
+
+int quantum_controller_tune_quantum(const QuantumController* controller, int quantum) {
+    double factor = 1.0; // Sin cambios por defecto
+    
+    if (controller->ready_wait_ms > CONTROLLER_TARGET_READY_WAIT) { // La cola de listos espera demasiado: latencia de cola alta
+        factor = CONTROLLER_TARGET_READY_WAIT / controller->ready_wait_ms; // Reduce en proporción al exceso
+        if (factor < CONTROLLER_MIN_SHRINK_FACTOR) factor = CONTROLLER_MIN_SHRINK_FACTOR; // Sin saltos bruscos
+    } else if (controller->switch_ratio > CONTROLLER_MAX_SWITCH_RATIO && controller->io_ratio < CONTROLLER_IO_BOUND_RATIO) { // Carga de CPU cortada por el quantum
+        factor = CONTROLLER_GROWTH_FACTOR; // Un quantum mayor evita cambios de contexto inútiles
+    }
+    
+    int tuned = (int)(quantum * factor); // Nuevo quantum
+    if (tuned < MIN_QUANTUM) tuned = MIN_QUANTUM; // Sin bajar del mínimo
+    if (tuned > MAX_QUANTUM) tuned = MAX_QUANTUM; // Sin superar el máximo
+    return tuned; // Devuelve el nuevo quantum
+}
+
+bool quantum_controller_should_switch(const QuantumController* controller, SchedulingPolicy current, SchedulingPolicy alternative) {
+    if (!controller->policy_measured[current]) return false; // Primero hay que medir la política actual
+    if (!controller->policy_measured[alternative]) return true; // La otra política aún no se ha probado
+    return controller->policy_ready_wait_ms[current] > controller->policy_ready_wait_ms[alternative] * CONTROLLER_SWITCH_MARGIN; // Cambia solo si la otra espera claramente menos
+}
@@ -0,0 +1,332 @@
+#include <stdio.h> // Biblioteca de entrada/salida estándar
+#include <stdlib.h> // Biblioteca de funciones de uso general
+#include <string.h> // Biblioteca de strings
+#include "../include/core/replay.h" // Reproducción de trazas
+#include "../include/core/trace.h" // Traza binaria
+#include "../include/core/policies.h" // Políticas de planificación
+#include "../include/core/scheduler.h" // Planificador
+#include "../include/core/clock.h" // Reloj monótono
+
+// Añade una espera medida a las estadísticas
+static void stats_add_wait(ReplayStats* stats, clock_ns_t wait_ns) {
+    if (stats->wait_count == stats->wait_capacity) { // Arreglo lleno
+        stats->wait_capacity = stats->wait_capacity ? stats->wait_capacity * 2 : 64; // Duplica la capacidad
+        stats->ready_waits_ms = realloc(stats->ready_waits_ms, stats->wait_capacity * sizeof(double)); // Amplía el arreglo
+    }
+    stats->ready_waits_ms[stats->wait_count++] = (double)wait_ns / CLOCK_NS_PER_MS; // Guarda la espera en milisegundos
+}
+
+// Añade una fase a la carga de un proceso
+static void add_phase(ReplayProcess* process, clock_ns_t cpu_ns, int io_ms, int size) {
+    if (process->phase_count == process->phase_capacity) { // Arreglo lleno
+        process->phase_capacity = process->phase_capacity ? process->phase_capacity * 2 : 8; // Duplica la capacidad
+        process->phases = realloc(process->phases, process->phase_capacity * sizeof(ReplayPhase)); // Amplía el arreglo
+    }
+    process->phases[process->phase_count++] = (ReplayPhase){ cpu_ns, io_ms, size }; // Guarda la fase
+}
+
+// Reconstruye la carga de cada proceso y mide la ejecución grabada
+static ReplayProcess* build_workload(const TraceRecord* records, size_t count, int* process_count, int* initial_quantum, ReplayStats* recorded) {
+    int max_index = -1; // Mayor índice de proceso de la traza
+    for (size_t i = 0; i < count; i++) { // Recorre los registros
+        if (records[i].process > max_index) max_index = records[i].process; // Actualiza el máximo
+    }
+
+    *process_count = max_index + 1; // Un hueco por índice
+    ReplayProcess* processes = calloc(*process_count > 0 ? *process_count : 1, sizeof(ReplayProcess)); // Procesos reconstruidos
+    for (int i = 0; i < *process_count; i++) { // Inicializa los procesos
+        processes[i].recorded_run_start = -1; // Sin ejecución en curso
+        processes[i].recorded_ready_since = -1; // Sin espera en curso
+    }
+
+    clock_ns_t* cpu_in_phase = calloc(*process_count > 0 ? *process_count : 1, sizeof(clock_ns_t)); // CPU acumulada de la fase en curso
+    int* size_in_phase = calloc(*process_count > 0 ? *process_count : 1, sizeof(int)); // Tamaño observado al empezar la fase
+    *initial_quantum = 0; // Sin quantum grabado
+
+    for (size_t i = 0; i < count; i++) { // Recorre la traza en orden
+        const TraceRecord* record = &records[i]; // Registro actual
+        if (record->type == TRACE_QUANTUM && *initial_quantum == 0) *initial_quantum = record->value; // Primer quantum grabado
+        if (record->process < 0) continue; // Evento global
+
+        ReplayProcess* process = &processes[record->process]; // Proceso del evento
+        int index = record->process; // Índice del proceso
+        switch (record->type) { // Según el tipo de evento
+            case TRACE_SPAWN: // Nacimiento
+                process->present = true; // El proceso existe
+                process->arrival_ns = record->time_ns; // Momento de llegada
+                process->recorded_ready_since = record->time_ns; // Entra en listos al nacer
+                size_in_phase[index] = record->size; // Tamaño inicial
+                break;
+            case TRACE_DISPATCH: // Despacho
+                if (process->recorded_ready_since >= 0) stats_add_wait(recorded, record->time_ns - process->recorded_ready_since); // Espera grabada
+                process->recorded_ready_since = -1; // Deja de esperar
+                process->recorded_run_start = record->time_ns; // Empieza a ejecutarse
+                break;
+            case TRACE_PREEMPT: // Expulsión
+            case TRACE_IO_START: // Inicio de E/S
+                if (process->recorded_run_start >= 0) { // Si se estaba ejecutando
+                    cpu_in_phase[index] += record->time_ns - process->recorded_run_start; // Acumula la CPU de la ráfaga
+                    process->recorded_run_start = -1; // Deja de ejecutarse
+                }
+                if (record->type == TRACE_PREEMPT) { // Vuelve a listos
+                    recorded->preemptions++; // Cuenta la expulsión
+                    process->recorded_ready_since = record->time_ns; // Empieza a esperar
+                } else { // Termina la fase con una E/S
+                    recorded->io_operations++; // Cuenta la E/S
+                    add_phase(process, cpu_in_phase[index], record->value, size_in_phase[index] ? size_in_phase[index] : record->size); // Cierra la fase
+                    cpu_in_phase[index] = 0; // La siguiente fase empieza sin CPU
+                    size_in_phase[index] = record->size; // Tamaño al empezar la siguiente fase
+                }
+                break;
+            case TRACE_IO_END: // Fin de E/S
+                process->recorded_ready_since = record->time_ns; // Empieza a esperar en listos
+                break;
+            default: // Otros eventos no afectan a la carga
+                break;
+        }
+    }
+
+    clock_ns_t end_ns = count > 0 ? records[count - 1].time_ns : 0; // Fin de la traza
+    recorded->makespan_ns = end_ns; // Duración grabada
+    for (int i = 0; i < *process_count; i++) { // Cierra la última fase de cada proceso
+        if (!processes[i].present) continue; // Hueco sin proceso
+        if (processes[i].recorded_run_start >= 0) cpu_in_phase[i] += end_ns - processes[i].recorded_run_start; // Seguía ejecutándose al final
+        add_phase(&processes[i], cpu_in_phase[i], -1, size_in_phase[i]); // Última fase, sin E/S
+    }
+    
+    free(cpu_in_phase); // Libera la CPU acumulada
+    free(size_in_phase); // Libera los tamaños
+    return processes; // Devuelve la carga reconstruida
+}
+
+// Prepara un proceso para empezar una fase
+static void start_phase(ReplayProcess* process) {
+    ReplayPhase* phase = &process->phases[process->current_phase]; // Fase en curso
+    process->remaining_ns = phase->cpu_ns; // CPU pendiente
+    process->hive.bees_and_honey_count = phase->size; // El tamaño de la fase guía a FSJ y al reparto ponderado
+}
+
+// Pone un proceso en la cola de listos de su núcleo
+static void replay_make_ready(ReplayProcess* process, ReadyQueue** queues, clock_ns_t now) {
+    process->state = READY; // Pasa a listos
+    process->ready_since = now; // Empieza a esperar
+    ready_queue_push(queues[process->info.slot], &process->info, now); // Encola según la política
+}
+
+// Toma el siguiente proceso para un núcleo (su cola o la más cargada)
+static ProcessInfo* replay_next(ReadyQueue** queues, int slot_count, int slot) {
+    ProcessInfo* next = ready_queue_pop(queues[slot]); // Cola local
+    if (next) return next; // Hay trabajo local
+
+    int victim = -1; // Cola de la que robar
+    for (int i = 0; i < slot_count; i++) { // Busca la cola más cargada
+        if (i != slot && queues[i]->size > 0 && (victim < 0 || queues[i]->size > queues[victim]->size)) victim = i; // Actualiza la víctima
+    }
+    return victim >= 0 ? ready_queue_pop(queues[victim]) : NULL; // Roba la cima de la víctima
+}
+
+// Simula la carga con una política en tiempo virtual
+static void simulate(ReplayProcess* processes, int process_count, int slot_count, ReplayStats* stats) {
+    ReadyQueue* queues[MAX_DISPATCH_SLOTS]; // Colas de listos simuladas
+    ProcessInfo* running[MAX_DISPATCH_SLOTS] = { NULL }; // Proceso activo de cada núcleo
+    for (int i = 0; i < slot_count; i++) { // Crea las colas
+        queues[i] = malloc(sizeof(ReadyQueue)); // Cola de listos simulada
+        init_ready_queue(queues[i], process_count > 0 ? process_count : 1); // Vacía; crece hasta el número de procesos de la traza
+    }
+
+    int pending = 0; // Procesos con carga pendiente
+    for (int i = 0; i < process_count; i++) { // Prepara los procesos
+        ReplayProcess* process = &processes[i]; // Proceso actual
+        if (!process->present) continue; // Hueco sin proceso
+        memset(&process->info, 0, sizeof(ProcessInfo)); // Proceso simulado limpio
+        process->info.hive = &process->hive; // Las políticas leen el tamaño de la colmena
+        process->info.index = i; // Índice del proceso
+        process->info.slot = i % slot_count; // Mismo núcleo de origen que en la ejecución real
+        process->info.ready_queue_index = -1; // Fuera de la cola
+        process->current_phase = 0; // Primera fase
+        process->arrived = false; // Aún no ha nacido
+        process->finished = false; // Carga pendiente
+        start_phase(process); // Carga de la primera fase
+        pending++; // Cuenta el proceso
+    }
+
+    clock_ns_t tick_ns = clock_ms_to_ns(SCHEDULER_TICK_MS); // Periodo de decisión del planificador
+    clock_ns_t now = 0; // Tiempo virtual
+    clock_ns_t next_tick = 0; // Próxima decisión
+    double turnaround_total_ms = 0.0; // Suma de tiempos de retorno
+    int finished = 0; // Procesos terminados
+
+    while (pending > 0) { // Hasta consumir toda la carga
+        clock_ns_t next = next_tick; // Próximo evento (como muy tarde, la próxima decisión)
+        for (int i = 0; i < process_count; i++) { // Busca el evento más próximo
+            ReplayProcess* process = &processes[i]; // Proceso actual
+            if (!process->present || process->finished) continue; // Sin eventos
+            if (!process->arrived && process->arrival_ns < next) next = process->arrival_ns; // Nacimiento
+            if (process->state == WAITING && process->io_done_at < next) next = process->io_done_at; // Fin de E/S
+            if (process->arrived && process->state == RUNNING && process->info.last_account_time + process->remaining_ns < next) next = process->info.last_account_time + process->remaining_ns; // Fin de ráfaga
+        }
+        if (next < now) next = now; // El tiempo no retrocede
+        now = next; // Avanza el tiempo virtual hasta el evento
+
+        for (int s = 0; s < slot_count; s++) { // Ráfagas que terminan ahora
+            if (!running[s]) continue; // Núcleo libre
+            ReplayProcess* process = &processes[running[s]->index]; // Proceso activo
+            if (process->info.last_account_time + process->remaining_ns > now) continue; // Aún le queda CPU
+
+            scheduler_state.policy->tick(&process->info, now - process->info.last_account_time, now - process->info.last_quantum_start, NULL); // Contabiliza la ráfaga
+            running[s] = NULL; // Libera el núcleo
+            ReplayPhase* phase = &process->phases[process->current_phase]; // Fase que termina
+            if (phase->io_ms < 0) { // Era la última fase
+                process->finished = true; // Carga consumida
+                process->finished_at = now; // Momento de fin
+                turnaround_total_ms += (double)(now - process->arrival_ns) / CLOCK_NS_PER_MS; // Tiempo de retorno
+                finished++; // Cuenta el proceso terminado
+                pending--; // Un proceso menos
+            } else { // Pide E/S
+                process->state = WAITING; // Espera de E/S
+                process->io_done_at = now + clock_ms_to_ns(phase->io_ms); // Fin exacto de la E/S
+                stats->io_operations++; // Cuenta la E/S
+                process->current_phase++; // Siguiente fase
+                start_phase(process); // Carga de la siguiente fase
+            }
+        }
+
+        for (int i = 0; i < process_count; i++) { // Nacimientos y fines de E/S
+            ReplayProcess* process = &processes[i]; // Proceso actual
+            if (!process->present || process->finished) continue; // Sin eventos
+            if (!process->arrived && process->arrival_ns <= now) { // Nace ahora
+                process->arrived = true; // Ya existe
+                replay_make_ready(process, queues, now); // Entra en listos
+            } else if (process->arrived && process->state == WAITING && process->io_done_at <= now) { // Termina su E/S
+                replay_make_ready(process, queues, now); // Vuelve a listos
+            }
+        }
+
+        if (now < next_tick) continue; // Las decisiones solo se toman en cada ciclo del planificador
+        next_tick += tick_ns; // Programa la siguiente decisión
+        for (int s = 0; s < slot_count; s++) { // Envejece las colas como el planificador real
+            age_ready_queue(queues[s], now); // La política decide
+        }
+
+        for (int s = 0; s < slot_count; s++) { // Decisión de cada núcleo
+            ProcessInfo* current = running[s]; // Proceso activo
+            if (current) { // Contabiliza y decide si cede el núcleo
+                ProcessInfo* top = queues[s]->size > 0 ? queues[s]->processes[0] : NULL; // Cima de la cola local
+                ReplayProcess* process = &processes[current->index]; // Proceso activo
+                clock_ns_t ran = now - current->last_account_time; // CPU desde la última contabilidad
+                process->remaining_ns -= ran; // Consume CPU de la fase
+                bool expired = scheduler_state.policy->tick(current, ran, now - current->last_quantum_start, top); // La política decide
+                current->last_account_time = now; // Siguiente tramo
+                if (!expired && !scheduler_state.policy->uses_quantum && top) { // Políticas expulsivas
+                    expired = scheduler_state.policy->preempt_check(top, current); // El candidato desplaza al activo
+                }
+                if (expired) { // El activo cede el núcleo
+                    running[s] = NULL; // Libera el núcleo
+                    stats->preemptions++; // Cuenta la expulsión
+                    replay_make_ready(process, queues, now); // Vuelve a listos
+                }
+            }
+            if (!running[s]) { // Núcleo libre
+                ProcessInfo* next_process = replay_next(queues, slot_count, s); // Siguiente proceso
+                if (next_process) { // Hay trabajo
+                    ReplayProcess* process = &processes[next_process->index]; // Proceso despachado
+                    stats_add_wait(stats, now - process->ready_since); // Espera en listos
+                    process->state = RUNNING; // Entra en ejecución
+                    next_process->slot = s; // Queda asociado al núcleo
+                    next_process->last_quantum_start = now; // Empieza su quantum
+                    next_process->last_account_time = now; // Empieza su contabilidad
+                    running[s] = next_process; // Ocupa el núcleo
+                }
+            }
+        }
+    }
+
+    stats->makespan_ns = now; // Tiempo total simulado
+    stats->mean_turnaround_ms = finished > 0 ? turnaround_total_ms / finished : 0.0; // Retorno medio
+    for (int i = 0; i < slot_count; i++) { // Libera las colas
+        cleanup_ready_queue(queues[i]); // Libera el montículo y el mutex
+        free(queues[i]); // Libera la cola
+    }
+}
+
+// Compara dos esperas (para ordenar)
+static int compare_waits(const void* a, const void* b) {
+    double x = *(const double*)a; // Primera espera
+    double y = *(const double*)b; // Segunda espera
+    return (x > y) - (x < y); // Orden ascendente
+}
+
+// Percentil de un arreglo ordenado
+static double percentile(const double* sorted, int count, double p) {
+    if (count <= 0 || !sorted) return 0.0; // Sin medidas
+    int index = (int)(p * (count - 1) + 0.5); // Posición del percentil
+    return sorted[index]; // Devuelve el valor
+}
+
+// Imprime las medidas de una ejecución
+static void print_stats(const char* label, ReplayStats* stats) {
+    if (stats->wait_count > 0) { // Sin despachos no hay arreglo de esperas
+        qsort(stats->ready_waits_ms, stats->wait_count, sizeof(double), compare_waits); // Ordena las esperas
+    }
+    double total = 0.0; // Suma de esperas
+    for (int i = 0; i < stats->wait_count; i++) total += stats->ready_waits_ms[i]; // Acumula las esperas
+
+    printf("%-40s despachos %6d | espera media %9.0f ms | p50 %8.0f | p95 %8.0f | p99 %8.0f | máx %8.0f | expulsiones %5d | E/S %5d | duración %7.1f s", label, stats->wait_count, stats->wait_count ? total / stats->wait_count : 0.0, percentile(stats->ready_waits_ms, stats->wait_count, 0.50), percentile(stats->ready_waits_ms, stats->wait_count, 0.95), percentile(stats->ready_waits_ms, stats->wait_count, 0.99), stats->wait_count ? stats->ready_waits_ms[stats->wait_count - 1] : 0.0, stats->preemptions, stats->io_operations, (double)stats->makespan_ns / CLOCK_NS_PER_SEC); // Imprime la fila
+    if (stats->mean_turnaround_ms > 0.0) printf(" | retorno medio %.0f ms", stats->mean_turnaround_ms); // Retorno medio (solo en la reproducción)
+    printf("\n"); // Fin de la fila
+}
+
+int run_trace_replay(const char* path, const char* policy_name) {
+    TraceHeader header; // Cabecera de la traza
+    size_t count = 0; // Número de registros
+    TraceRecord* records = load_trace(path, &header, &count); // Lee la traza
+    if (!records) { // Traza inexistente o inválida
+        fprintf(stderr, "Error: no se pudo leer la traza %s\n", path); // Imprime el error
+        return 1; // Código de error
+    }
+
+    SchedulingPolicy first = ROUND_ROBIN; // Primera política a reproducir
+    SchedulingPolicy last = ROUND_ROBIN; // Última política a reproducir
+    if (!policy_name || strcmp(policy_name, "all") == 0) { // Comparar todas las políticas (por defecto)
+        first = 0; // Desde la primera
+        last = POLICY_COUNT - 1; // Hasta la última
+    } else if (!parse_scheduling_policy(policy_name, &first)) { // Política desconocida
+        fprintf(stderr, "Error: política desconocida '%s' (rr, sjf, mlfq, cfs, wfs, all)\n", policy_name); // Imprime el error
+        free(records); // Libera la traza
+        return 1; // Código de error
+    } else { // Una sola política
+        last = first; // Solo esa
+    }
+
+    int process_count = 0; // Número de huecos de proceso
+    int quantum = 0; // Quantum inicial grabado
+    ReplayStats recorded = { 0 }; // Medidas de la ejecución grabada
+    ReplayProcess* processes = build_workload(records, count, &process_count, &quantum, &recorded); // Reconstruye la carga
+    int slot_count = header.slot_count > 0 && header.slot_count <= MAX_DISPATCH_SLOTS ? header.slot_count : 1; // Núcleos de la ejecución grabada
+    scheduler_state.current_quantum = quantum > 0 ? quantum : MIN_QUANTUM; // Las políticas con quantum usan el grabado
+
+    int process_total = 0; // Procesos reales
+    for (int i = 0; i < process_count; i++) process_total += processes[i].present; // Cuenta los procesos
+    printf("\n=== Reproducción de traza ===\n"); // Imprime la cabecera
+    printf("├─ Traza: %s (%zu eventos, %d colmenas, %d núcleos)\n", path, count, process_total, slot_count); // Datos de la traza
+    printf("└─ Quantum: %d ms, ciclo del planificador: %d ms\n\n", scheduler_state.current_quantum, SCHEDULER_TICK_MS); // Parámetros de la simulación
+    print_stats("Grabado", &recorded); // Medidas de la ejecución original
+
+    for (int p = first; p <= (int)last; p++) { // Reproduce cada política pedida
+        scheduler_state.policy = get_policy_ops((SchedulingPolicy)p); // La política ordena las colas simuladas
+        scheduler_state.current_policy = (SchedulingPolicy)p; // Política actual
+        ReplayStats stats = { 0 }; // Medidas de la reproducción
+        clock_ns_t started = clock_now_ns(); // Inicio real de la reproducción
+        simulate(processes, process_count, slot_count, &stats); // Simula en tiempo virtual
+        char label[80]; // Etiqueta de la fila
+        snprintf(label, sizeof(label), "%s (%.1f ms reales)", scheduler_state.policy->short_name, clock_elapsed_ms(started, clock_now_ns())); // Política y tiempo real empleado
+        print_stats(label, &stats); // Imprime las medidas
+        free(stats.ready_waits_ms); // Libera las esperas
+    }
+
+    for (int i = 0; i < process_count; i++) free(processes[i].phases); // Libera las fases
+    free(processes); // Libera los procesos
+    free(recorded.ready_waits_ms); // Libera las esperas grabadas
+    free(records); // Libera la traza
+    return 0; // Éxito
+}
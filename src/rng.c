@@ -0,0 +1,78 @@
+#include "../include/core/rng.h" // Generador de números aleatorios
+
+static uint64_t master_seed = 0x853C49E6748FEA9Bull; // Semilla maestra (se fija al arrancar)
+
+// Mezclador de splitmix64: dispersa bien valores consecutivos
+static uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull; // Primera ronda
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull; // Segunda ronda
+    return z ^ (z >> 31); // Resultado mezclado
+}
+
+// Siguiente valor de splitmix64 (solo para sembrar xoshiro)
+static uint64_t splitmix64(uint64_t* state) {
+    *state += 0x9E3779B97F4A7C15ull; // Avanza el estado
+    return mix64(*state); // Mezcla el estado
+}
+
+// Rotación a la izquierda
+static inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k)); // Rota k bits
+}
+
+void rng_set_master_seed(uint64_t seed) {
+    master_seed = seed; // Guarda la semilla
+}
+
+uint64_t rng_master_seed(void) {
+    return master_seed; // Devuelve la semilla
+}
+
+void rng_stream_init(RngStream* rng, uint64_t stream_id) {
+    uint64_t state = master_seed ^ mix64(stream_id + 0x9E3779B97F4A7C15ull); // Punto de partida propio del flujo
+    for (int i = 0; i < 4; i++) { // Llena el estado
+        rng->s[i] = splitmix64(&state); // Palabra de estado
+    }
+}
+
+uint64_t rng_next(RngStream* rng) {
+    uint64_t* s = rng->s; // Estado del flujo
+    uint64_t result = rotl(s[1] * 5, 7) * 9; // Salida de xoshiro256**
+    uint64_t t = s[1] << 17; // Término de desplazamiento
+    
+    s[2] ^= s[0]; // Avanza el estado
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    
+    return result; // Devuelve el valor
+}
+
+int rng_range(RngStream* rng, int min, int max) {
+    uint32_t range = (uint32_t)(max - min) + 1; // Número de valores posibles
+    uint64_t m = (rng_next(rng) >> 32) * (uint64_t)range; // Multiplicación de Lemire (sin división en el caso común)
+    uint32_t low = (uint32_t)m; // Parte baja
+    if (low < range) { // Posible sesgo: se rechaza el tramo sobrante
+        uint32_t threshold = -range % range; // Tramo sobrante
+        while (low < threshold) { // Repite hasta salir del tramo
+            m = (rng_next(rng) >> 32) * (uint64_t)range; // Nuevo intento
+            low = (uint32_t)m; // Parte baja
+        }
+    }
+    return min + (int)(m >> 32); // Parte alta: valor uniforme en [0, range)
+}
+
+// Sin rechazo: el sesgo es menor que rango / 2^32, despreciable para los rangos de la simulación
+void rng_fill_range(RngStream* rng, int* out, int count, int min, int max) {
+    uint64_t range = (uint64_t)(max - min) + 1; // Número de valores posibles
+    for (int i = 0; i + 1 < count; i += 2) { // Dos valores de 32 bits por cada llamada al generador
+        uint64_t bits = rng_next(rng); // 64 bits aleatorios
+        out[i] = min + (int)(((bits >> 32) * range) >> 32); // Mitad alta
+        out[i + 1] = min + (int)(((bits & 0xFFFFFFFFull) * range) >> 32); // Mitad baja
+    }
+    if (count % 2) { // Valor suelto
+        out[count - 1] = min + (int)(((rng_next(rng) >> 32) * range) >> 32); // Último valor
+    }
+}
@@ -5,98 +5,388 @@
 #include "../include/core/scheduler.h" // Planificador
 #include "../include/core/file_manager.h" // Gestión de archivos
 #include "../include/core/utils.h" // Utilidades
+#include "../include/core/clock.h" // Reloj monótono
+#include "../include/core/thread_pool.h" // Pool de trabajadores
+#include "../include/core/beehive.h" // Colmena
+#include "../include/core/policies.h" // Políticas de planificación
+#include "../include/core/quantum_controller.h" // Controlador adaptativo de quantum
+#include "../include/core/trace.h" // Traza binaria
+#include "../include/core/rng.h" // Generador de números aleatorios
+#include "../include/core/sim.h" // Simulación en tiempo virtual
+#include "../include/core/hive_slab.h" // Asignador de colmenas
 
 // Instancia del estado del planificador
 SchedulerState scheduler_state;
 
 // Funciones de utilidad privadas
+static int ready_queue_size(ReadyQueue* queue) { // Tamaño de la cola de listos (lectura relajada: sin el mutex es solo una pista)
+    return atomic_load_explicit(&queue->size, memory_order_relaxed); // Devuelve el tamaño de la cola
+}
+
+static void set_ready_queue_size(ReadyQueue* queue, int size) { // Actualiza el tamaño de la cola de listos (el llamador tiene su mutex)
+    atomic_store_explicit(&queue->size, size, memory_order_relaxed); // Publica el nuevo tamaño
+}
+
 static bool is_queue_empty(ReadyQueue* queue) { // Verifica si la cola de listos está vacía
-    return queue->size == 0; // Devuelve si la cola de listos está vacía
+    return ready_queue_size(queue) == 0; // Devuelve si la cola de listos está vacía
+}
+
+// Nueva capacidad al llenarse una cola: el doble, sin pasar del máximo
+static int grown_capacity(int capacity, int limit) {
+    int grown = capacity < QUEUE_INITIAL_CAPACITY ? QUEUE_INITIAL_CAPACITY : capacity * 2; // Duplica la capacidad
+    return grown < limit ? grown : limit; // Sin superar el máximo de procesos
 }
 
-// Verifica si la cola de E/S está llena
-static bool is_queue_full(ReadyQueue* queue) { 
-    return queue->size >= MAX_PROCESSES; // Devuelve si la cola de listos está llena
+// Garantiza un hueco libre en la cola de listos; devuelve false si la cola está llena (el llamador tiene su mutex)
+static bool ready_queue_reserve(ReadyQueue* queue) {
+    if (ready_queue_size(queue) < queue->capacity) return true; // Queda sitio
+    if (queue->capacity >= queue->limit) return false; // Alcanzado el máximo de procesos
+    int capacity = grown_capacity(queue->capacity, queue->limit); // Nueva capacidad
+    ProcessInfo** processes = realloc(queue->processes, capacity * sizeof(ProcessInfo*)); // Amplía el montículo (los índices no cambian)
+    if (!processes) return false; // Sin memoria: se trata como cola llena
+    queue->processes = processes; // Nuevo montículo
+    queue->capacity = capacity; // Nueva capacidad
+    return true; // Hay sitio
+}
+
+// Inicializa una cola de listos vacía que crece bajo demanda hasta limit procesos
+void init_ready_queue(ReadyQueue* queue, int limit) {
+    queue->processes = NULL; // Sin huecos reservados todavía
+    atomic_init(&queue->size, 0); // Inicializa el tamaño de la cola de listos
+    queue->capacity = 0; // Se reserva al encolar el primer proceso
+    queue->limit = limit; // Máximo de procesos
+    queue->next_sequence = 0; // Inicializa el orden de llegada
+    queue->min_vruntime = 0; // Inicializa el tiempo virtual mínimo
+    pthread_mutex_init(&queue->mutex, NULL); // Crea el mutex para el acceso a la cola de listos
+}
+
+// Libera el montículo y el mutex de una cola de listos
+void cleanup_ready_queue(ReadyQueue* queue) {
+    pthread_mutex_destroy(&queue->mutex); // Limpia el mutex de la cola de listos
+    free(queue->processes); // Libera el montículo
+    queue->processes = NULL; // Sin huecos reservados
+    set_ready_queue_size(queue, 0); // Cola vacía
+    queue->capacity = 0; // Sin capacidad
 }
 
 // Inicialización de semáforos y recursos
 void init_process_semaphores(ProcessInfo* process) {
     if (!process) return; // Si no hay bloque de control de procesos, devuelve
-    process->shared_resource_sem = malloc(sizeof(sem_t)); // Crea un semáforo compartido
+    process->shared_resource_sem = hive_slab_sem(process); // Semáforo del bloque de la colmena
     sem_init(process->shared_resource_sem, 0, 1); // Inicializa el semáforo
-    process->last_quantum_start = time(NULL); // Obtiene la hora de inicio del quantum
+    process->last_quantum_start = clock_now_ns(); // Obtiene la hora de inicio del quantum
+    process->slot = -1; // Aún sin núcleo de despacho asignado
+    process->ready_queue_index = -1; // Aún fuera de la cola de listos
+    process->last_account_time = 0; // Aún sin CPU consumida
+    process->mlfq_level = 0; // Empieza en el nivel más prioritario
+    process->mlfq_level_since = 0; // Se fija al entrar en la cola multinivel
+    process->vruntime = 0; // Se ajusta al mínimo de la cola al encolarse
+    process->handoff_next = NULL; // Fuera de la pila de traspaso
 }
 
 // Limpia y destruye los semáforos asociados a un proceso
 void cleanup_process_semaphores(ProcessInfo* process) {
     if (!process || !process->shared_resource_sem) return; // Si no hay bloque de control de procesos o semáforo compartido, devuelve
-    sem_destroy(process->shared_resource_sem); // Destruye el semáforo compartido
-    free(process->shared_resource_sem); // Libera el semáforo compartido
-    process->shared_resource_sem = NULL; // Libera la memoria del semáforo compartido
+    sem_destroy(process->shared_resource_sem); // Destruye el semáforo compartido (se devuelve con el bloque)
+    process->shared_resource_sem = NULL; // Sin semáforo
 }
 
-// Gestión de cola de listos
-void add_to_ready_queue(ProcessInfo* process) {
-    if (!process || !scheduler_state.ready_queue) return; // Si no hay bloque de control de procesos o cola de listos, devuelve
+// Montículo de listos: indica si el proceso a debe ejecutarse antes que b
+static bool ready_queue_precedes(const ProcessInfo* a, const ProcessInfo* b) {
+    return scheduler_state.policy->precedes(a, b); // El criterio lo define la política actual
+}
 
-    pthread_mutex_lock(&scheduler_state.ready_queue->mutex); // Bloquea el mutex para el acceso a la cola de listos
-    
-    if (!is_queue_full(scheduler_state.ready_queue)) { // Si la cola de listos no está llena
-        scheduler_state.ready_queue->processes[scheduler_state.ready_queue->size] = process; // Añade el proceso a la cola de listos
-        scheduler_state.ready_queue->size++; // Incrementa el número de procesos en la cola de listos
-        
-        if (scheduler_state.current_policy == SHORTEST_JOB_FIRST) { // Si la política es FSJ
-            sort_ready_queue_fsj(); // Ordena la cola de listos
+// Coloca un proceso en una posición del montículo y actualiza su índice
+static void ready_queue_place(ReadyQueue* queue, int index, ProcessInfo* process) {
+    queue->processes[index] = process; // Guarda el proceso en la posición
+    process->ready_queue_index = index; // Recuerda la posición para reubicarlo en O(log n)
+}
+
+// Sube un proceso hacia la cima mientras preceda a su padre
+static void ready_queue_sift_up(ReadyQueue* queue, int index) {
+    ProcessInfo* process = queue->processes[index]; // Proceso a reubicar
+    while (index > 0) { // Mientras no se llegue a la cima
+        int parent = (index - 1) / 2; // Índice del padre
+        if (!ready_queue_precedes(process, queue->processes[parent])) break; // El padre ya va antes
+        ready_queue_place(queue, index, queue->processes[parent]); // Baja el padre
+        index = parent; // Continúa desde la posición del padre
+    }
+    ready_queue_place(queue, index, process); // Coloca el proceso en su posición final
+}
+
+// Baja un proceso hacia las hojas mientras algún hijo lo preceda
+static void ready_queue_sift_down(ReadyQueue* queue, int index) {
+    ProcessInfo* process = queue->processes[index]; // Proceso a reubicar
+    int size = ready_queue_size(queue); // Tamaño del montículo (no cambia mientras se baja)
+    while (true) {
+        int child = 2 * index + 1; // Hijo izquierdo
+        if (child >= size) break; // No hay hijos
+        if (child + 1 < size && ready_queue_precedes(queue->processes[child + 1], queue->processes[child])) { // El hijo derecho va antes
+            child++; // Se usa el hijo derecho
         }
+        if (!ready_queue_precedes(queue->processes[child], process)) break; // El proceso ya va antes que sus hijos
+        ready_queue_place(queue, index, queue->processes[child]); // Sube el hijo
+        index = child; // Continúa desde la posición del hijo
     }
+    ready_queue_place(queue, index, process); // Coloca el proceso en su posición final
+}
 
-    scheduler_state.process_table->ready_processes = scheduler_state.ready_queue->size; // Actualiza la tabla de procesos
-    
-    pthread_mutex_unlock(&scheduler_state.ready_queue->mutex); // Desbloquea el mutex para el acceso a la cola de listos
+// Verifica si el proceso está actualmente en el montículo
+static bool ready_queue_contains(ReadyQueue* queue, ProcessInfo* process) {
+    int index = process->ready_queue_index; // Posición registrada del proceso
+    return index >= 0 && index < ready_queue_size(queue) && queue->processes[index] == process; // El índice debe apuntar al propio proceso
 }
 
-// Elimina un proceso de la cola de listos
-void remove_from_ready_queue(ProcessInfo* process) {
-    if (!process || !scheduler_state.ready_queue) return; // Si no hay bloque de control de procesos o cola de listos, devuelve
+// Extrae el proceso en una posición del montículo (requiere el mutex de la cola)
+static void ready_queue_remove_at(ReadyQueue* queue, int index) {
+    ProcessInfo* removed = queue->processes[index]; // Proceso a extraer
+    int size = ready_queue_size(queue) - 1; // Reduce el montículo
+    set_ready_queue_size(queue, size); // Publica el nuevo tamaño
+    if (index < size) { // Si no era el último elemento
+        ProcessInfo* moved = queue->processes[size]; // Último elemento del montículo
+        ready_queue_place(queue, index, moved); // Mueve el último al hueco
+        ready_queue_sift_down(queue, index); // Restaura el orden hacia abajo
+        ready_queue_sift_up(queue, moved->ready_queue_index); // O hacia arriba, según corresponda
+    }
+    removed->ready_queue_index = -1; // Marca el proceso como fuera de la cola
+}
+
+// Inserta un proceso en una cola de listos según la política actual
+bool ready_queue_push(ReadyQueue* queue, ProcessInfo* process, clock_ns_t now) {
+    pthread_mutex_lock(&queue->mutex); // Bloquea el mutex para el acceso a la cola de listos
+    
+    bool added = false; // Indica si se insertó el proceso
+    if (ready_queue_contains(queue, process)) { // El proceso ya está en la cola
+        added = false; // Nada que hacer
+    } else if (!ready_queue_reserve(queue)) { // La cola no puede crecer más
+        atomic_fetch_add(&scheduler_state.ready_overflows, 1); // Cuenta el desbordamiento (no se descarta en silencio)
+        log_printf("Cola de listos llena (%d procesos): proceso %d descartado\n", ready_queue_size(queue), process->index); // Imprime un mensaje de debug
+    } else { // Hay sitio en la cola de listos
+        scheduler_state.policy->enqueue(queue, process, now); // La política ajusta el proceso (nivel, tiempo virtual)
+        process->ready_sequence = queue->next_sequence++; // Asigna el orden de llegada
+        int size = ready_queue_size(queue); // Posición libre al final del montículo
+        ready_queue_place(queue, size, process); // Añade el proceso al final del montículo
+        set_ready_queue_size(queue, size + 1); // Incrementa el número de procesos en la cola de listos
+        ready_queue_sift_up(queue, size); // Sube el proceso a su posición (O(log n))
+        added = true; // Proceso insertado
+    }
+    
+    pthread_mutex_unlock(&queue->mutex); // Desbloquea el mutex para el acceso a la cola de listos
+    return added; // Retorna si se insertó
+}
 
-    int index = -1; // Obtiene el índice del proceso en la cola de listos
-    for (int i = 0; i < scheduler_state.ready_queue->size; i++) { // Recorre la cola de listos
-        if (scheduler_state.ready_queue->processes[i] == process) { // Si el proceso está en la cola de listos
-            index = i; // Actualiza el índice
-            break; // Salir de la bucle
+// Extrae la cima de una cola de listos
+ProcessInfo* ready_queue_pop(ReadyQueue* queue) {
+    pthread_mutex_lock(&queue->mutex); // Bloquea el mutex para el acceso a la cola de listos
+    
+    ProcessInfo* process = NULL; // Proceso extraído
+    if (!is_queue_empty(queue)) { // Si la cola de listos no está vacía
+        process = queue->processes[0]; // La cima del montículo es el siguiente proceso
+        ready_queue_remove_at(queue, 0); // Lo extrae en O(log n)
+        if (process->vruntime > queue->min_vruntime) { // El tiempo virtual mínimo solo avanza
+            queue->min_vruntime = process->vruntime; // Base para los procesos que lleguen después
         }
     }
     
-    if (index != -1) { // Si se ha encontrado el proceso en la cola de listos
-        for (int i = index; i < scheduler_state.ready_queue->size - 1; i++) { // Recorre la cola de listos
-            scheduler_state.ready_queue->processes[i] = scheduler_state.ready_queue->processes[i + 1]; // Mueve el proceso a la posición anterior
+    pthread_mutex_unlock(&queue->mutex); // Desbloquea el mutex para el acceso a la cola de listos
+    return process; // Retorna el proceso extraído (o NULL)
+}
+
+// Roba el siguiente proceso de la cola más cargada de otro núcleo
+static ProcessInfo* steal_ready_process(DispatchSlot* thief) {
+    DispatchSlot* victim = NULL; // Núcleo del que se roba
+    int victim_size = 0; // Tamaño de su cola
+    
+    for (int i = 0; i < scheduler_state.slot_count; i++) { // Recorre los demás núcleos
+        DispatchSlot* slot = &scheduler_state.slots[i]; // Núcleo candidato
+        int size = ready_queue_size(slot->ready_queue); // Lectura atómica sin bloqueo: solo es una pista de carga
+        if (slot != thief && size > victim_size) { // La cola tiene más trabajo que la elegida
+            victim = slot; // Elige el núcleo con más trabajo pendiente
+            victim_size = size; // Recuerda su tamaño
         }
-        scheduler_state.ready_queue->size--; // Decrementa el número de procesos en la cola de listos
     }
+    if (!victim) return NULL; // Nadie tiene trabajo pendiente
+    
+    ProcessInfo* stolen = ready_queue_pop(victim->ready_queue); // Toma la cima bajo el mutex de la víctima (nunca dos colas a la vez)
+    if (stolen) { // Si la cola no se vació mientras tanto
+        log_printf("Núcleo %d roba el proceso %d del núcleo %d\n", thief->id, stolen->index, victim->id); // Imprime un mensaje de debug
+    }
+    return stolen; // Retorna el proceso robado
+}
+
+// Cuenta los procesos listos en todos los núcleos
+int count_ready_processes(void) {
+    int total = 0; // Total de procesos listos
+    for (int i = 0; i < scheduler_state.slot_count; i++) { // Recorre los núcleos
+        total += ready_queue_size(scheduler_state.slots[i].ready_queue); // Suma el tamaño de cada cola local
+    }
+    return total; // Retorna el total
+}
+
+// Gestión de cola de listos
+void add_to_ready_queue(ProcessInfo* process) {
+    if (!process || scheduler_state.slot_count == 0) return; // Si no hay bloque de control de procesos o núcleos, devuelve
+
+    if (process->slot < 0 || process->slot >= scheduler_state.slot_count) { // Si el proceso aún no tiene núcleo
+        process->slot = process->index % scheduler_state.slot_count; // Reparte los procesos nuevos entre los núcleos
+    }
+    ready_queue_push(scheduler_state.slots[process->slot].ready_queue, process, clock_coarse_now_ns()); // Inserta en la cola local del núcleo del proceso
 
-    scheduler_state.process_table->ready_processes = scheduler_state.ready_queue->size; // Actualiza la tabla de procesos
+    scheduler_state.process_table->ready_processes = count_ready_processes(); // Actualiza la tabla de procesos
 }
 
-// Obtiene el siguiente proceso en la cola de listos
-ProcessInfo* get_next_ready_process(void) {
-    pthread_mutex_lock(&scheduler_state.ready_queue->mutex); // Bloquea el mutex para el acceso a la cola de listos
+// Publica un proceso listo sin tomar ningún mutex (lo puede llamar cualquier hilo)
+void publish_ready_process(ProcessInfo* process) {
+    if (!process) return; // Si no hay proceso, devuelve
     
-    ProcessInfo* next_process = NULL; // Proceso siguiente
-    if (!is_queue_empty(scheduler_state.ready_queue)) { // Si la cola de listos no está vacía
-        next_process = scheduler_state.ready_queue->processes[0]; // Obtiene el siguiente proceso
-        remove_from_ready_queue(next_process); // Elimina el proceso de la cola de listos
+    ReadyHandoff* handoff = &scheduler_state.ready_handoff; // Pila de traspaso
+    ProcessInfo* head = atomic_load_explicit(&handoff->head, memory_order_relaxed); // Cima actual
+    do {
+        process->handoff_next = head; // Enlaza el proceso sobre la cima actual
+    } while (!atomic_compare_exchange_weak_explicit(&handoff->head, &head, process, memory_order_release, memory_order_relaxed)); // Reintenta si otro productor publicó antes
+    atomic_fetch_add_explicit(&handoff->pending, 1, memory_order_relaxed); // Cuenta el proceso pendiente
+}
+
+// Drena la pila de traspaso y encola los procesos en orden de publicación (solo el hilo del planificador)
+int drain_ready_handoff(void) {
+    ReadyHandoff* handoff = &scheduler_state.ready_handoff; // Pila de traspaso
+    if (!atomic_load_explicit(&handoff->head, memory_order_relaxed)) return 0; // Nada publicado: sin operaciones atómicas de escritura
+    
+    ProcessInfo* batch = atomic_exchange_explicit(&handoff->head, NULL, memory_order_acquire); // Toma todo el lote de una vez
+    ProcessInfo* ordered = NULL; // Lote en orden de publicación
+    while (batch) { // Invierte la pila (LIFO) para respetar el orden de llegada
+        ProcessInfo* next = batch->handoff_next; // Siguiente en la pila
+        batch->handoff_next = ordered; // Enlaza delante del lote ordenado
+        ordered = batch; // Avanza el lote ordenado
+        batch = next; // Continúa con la pila
     }
     
-    pthread_mutex_unlock(&scheduler_state.ready_queue->mutex); // Desbloquea el mutex para el acceso a la cola de listos
+    int drained = 0; // Procesos encolados
+    while (ordered) { // Recorre el lote ordenado
+        ProcessInfo* process = ordered; // Proceso a encolar
+        ordered = process->handoff_next; // Avanza antes de desenlazar
+        process->handoff_next = NULL; // Fuera de la pila de traspaso
+        if (process->pcb->state == WAITING) { // Viene de completar su E/S
+            update_process_state(process, READY); // Actualizar estado
+        }
+        add_to_ready_queue(process); // Añadir a la cola de listos de su núcleo
+        drained++; // Cuenta el proceso encolado
+    }
+    atomic_fetch_sub_explicit(&handoff->pending, drained, memory_order_relaxed); // Descuenta los procesos drenados
+    return drained; // Retorna el número de procesos encolados
+}
+
+// Elimina un proceso de la cola de listos de su núcleo (el llamador debe tener el mutex de esa cola)
+void remove_from_ready_queue(ProcessInfo* process) {
+    if (!process || process->slot < 0 || process->slot >= scheduler_state.slot_count) return; // Si no hay proceso o no tiene núcleo, devuelve
+
+    ReadyQueue* queue = scheduler_state.slots[process->slot].ready_queue; // Cola local del núcleo del proceso
+    if (ready_queue_contains(queue, process)) { // Si se ha encontrado el proceso en la cola de listos
+        ready_queue_remove_at(queue, process->ready_queue_index); // Lo extrae en O(log n)
+    }
+}
+
+// Obtiene el siguiente proceso para un núcleo: primero de su cola local y, si está vacía, robando
+ProcessInfo* get_next_ready_process(DispatchSlot* slot) {
+    ProcessInfo* next_process = ready_queue_pop(slot->ready_queue); // Intenta con la cola local
+    if (!next_process) { // Núcleo ocioso
+        next_process = steal_ready_process(slot); // Roba trabajo de un núcleo ocupado
+    }
+    
+    if (next_process) { // Si hay siguiente proceso
+        next_process->slot = slot->id; // El proceso queda asociado al núcleo que lo ejecuta
+    }
+    scheduler_state.process_table->ready_processes = count_ready_processes(); // Actualiza la tabla de procesos
     return next_process; // Retorna el siguiente proceso
 }
 
+// Reubica un proceso en la cola de listos cuando cambia el tamaño de su colmena
+void update_ready_queue_priority(ProcessInfo* process) {
+    if (!process || process->slot < 0 || process->slot >= scheduler_state.slot_count) return; // Si no hay proceso o no tiene núcleo, devuelve
+
+    ReadyQueue* queue = scheduler_state.slots[process->slot].ready_queue; // Cola local del núcleo del proceso
+    pthread_mutex_lock(&queue->mutex); // Bloquea el mutex para el acceso a la cola de listos
+    
+    if (ready_queue_contains(queue, process)) { // Solo si el proceso está esperando en la cola
+        ready_queue_sift_up(queue, process->ready_queue_index); // Si su clave disminuyó, sube
+        ready_queue_sift_down(queue, process->ready_queue_index); // Si su clave aumentó, baja
+    }
+    
+    pthread_mutex_unlock(&queue->mutex); // Desbloquea el mutex para el acceso a la cola de listos
+}
+
+// Reconstruye el montículo tras un cambio de política (el llamador debe tener el mutex de la cola)
+void rebuild_ready_queue(ReadyQueue* queue) {
+    for (int i = ready_queue_size(queue) / 2 - 1; i >= 0; i--) { // Recorre los nodos internos de abajo hacia arriba
+        ready_queue_sift_down(queue, i); // Ordena cada subárbol (O(n) en total)
+    }
+}
+
+// Envejece los procesos que esperan en una cola y reordena el montículo si alguno cambió de prioridad
+void age_ready_queue(ReadyQueue* queue, clock_ns_t now) {
+    pthread_mutex_lock(&queue->mutex); // Bloquea la cola
+    bool changed = false; // Indica si alguna prioridad cambió
+    int size = ready_queue_size(queue); // Procesos en espera
+    for (int i = 0; i < size; i++) { // Recorre los procesos en espera
+        changed |= scheduler_state.policy->age(queue->processes[i], now); // La política decide
+    }
+    if (changed) rebuild_ready_queue(queue); // Reordena con las nuevas prioridades
+    pthread_mutex_unlock(&queue->mutex); // Desbloquea la cola
+}
+
+// Indica si la fecha límite ya se alcanzó
+static bool io_deadline_reached(clock_ns_t deadline, clock_ns_t now) {
+    return deadline <= now; // Las marcas monótonas se comparan directamente
+}
+
+// Sube una entrada hacia la cima mientras venza antes que su padre
+static void io_queue_sift_up(IOQueue* queue, int index) {
+    IOQueueEntry entry = queue->entries[index]; // Entrada a reubicar
+    while (index > 0) { // Mientras no se llegue a la cima
+        int parent = (index - 1) / 2; // Índice del padre
+        if (io_deadline_reached(queue->entries[parent].deadline, entry.deadline)) break; // El padre vence antes
+        queue->entries[index] = queue->entries[parent]; // Baja el padre
+        index = parent; // Continúa desde la posición del padre
+    }
+    queue->entries[index] = entry; // Coloca la entrada en su posición final
+}
+
+// Baja una entrada hacia las hojas mientras algún hijo venza antes
+static void io_queue_sift_down(IOQueue* queue, int index) {
+    IOQueueEntry entry = queue->entries[index]; // Entrada a reubicar
+    while (true) {
+        int child = 2 * index + 1; // Hijo izquierdo
+        if (child >= queue->size) break; // No hay hijos
+        if (child + 1 < queue->size && !io_deadline_reached(queue->entries[child].deadline, queue->entries[child + 1].deadline)) { // El hijo derecho vence antes
+            child++; // Se usa el hijo derecho
+        }
+        if (io_deadline_reached(entry.deadline, queue->entries[child].deadline)) break; // La entrada ya vence antes que sus hijos
+        queue->entries[index] = queue->entries[child]; // Sube el hijo
+        index = child; // Continúa desde la posición del hijo
+    }
+    queue->entries[index] = entry; // Coloca la entrada en su posición final
+}
+
+// Completa las E/S vencidas cuando lo indica la cola de eventos (tiempo virtual)
+static void io_completion_event(void* arg) {
+    (void)arg; // Sin uso
+    process_io_queue(); // Completa todas las E/S vencidas en un lote
+}
+
 // Gestión de cola de E/S
 void init_io_queue(void) {
     scheduler_state.io_queue = malloc(sizeof(IOQueue)); // Crea la cola de E/S
+    scheduler_state.io_queue->entries = NULL; // Se reserva con la primera E/S
     scheduler_state.io_queue->size = 0; // Inicializa el tamaño de la cola de E/S
+    scheduler_state.io_queue->capacity = 0; // Sin entradas reservadas
+    scheduler_state.io_queue->limit = scheduler_state.process_limit; // Un proceso espera como mucho una E/S a la vez
     pthread_mutex_init(&scheduler_state.io_queue->mutex, NULL); // Crea el mutex para el acceso a la cola de E/S
-    pthread_cond_init(&scheduler_state.io_queue->condition, NULL); // Crea la condición para espera de E/S
+    
+    pthread_condattr_t attr; // Atributos de la condición
+    pthread_condattr_init(&attr); // Inicializa los atributos
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC); // Las esperas con plazo usan el reloj monótono
+    pthread_cond_init(&scheduler_state.io_queue->condition, &attr); // Crea la condición para espera de E/S
+    pthread_condattr_destroy(&attr); // Libera los atributos
 }
 
 //Se Limpian los recursos asociados a la cola de entrada/salida
@@ -104,64 +394,83 @@ void cleanup_io_queue(void) {
     if (!scheduler_state.io_queue) return; // Si no hay cola de E/S, devuelve
     pthread_mutex_destroy(&scheduler_state.io_queue->mutex); // Libera el mutex para el acceso a la cola de E/S
     pthread_cond_destroy(&scheduler_state.io_queue->condition); // Libera la condición para espera de E/S
+    free(scheduler_state.io_queue->entries); // Libera las entradas
     free(scheduler_state.io_queue); // Libera la cola de E/S
 }
 
+// Garantiza una entrada libre en la cola de E/S; devuelve false si está llena (el llamador tiene su mutex)
+static bool io_queue_reserve(IOQueue* queue) {
+    if (queue->size < queue->capacity) return true; // Queda sitio
+    if (queue->capacity >= queue->limit) return false; // Alcanzado el máximo de procesos
+    int capacity = grown_capacity(queue->capacity, queue->limit); // Nueva capacidad
+    IOQueueEntry* entries = realloc(queue->entries, capacity * sizeof(IOQueueEntry)); // Amplía el montículo
+    if (!entries) return false; // Sin memoria: se trata como cola llena
+    queue->entries = entries; // Nuevo montículo
+    queue->capacity = capacity; // Nueva capacidad
+    return true; // Hay sitio
+}
+
 //Se añade un proceso a la cola de entrada/salida
 void add_to_io_queue(ProcessInfo* process) {
     if (!process || !scheduler_state.io_queue) return; // Si no hay bloque de control de procesos o cola de E/S, devuelve
 
     pthread_mutex_lock(&scheduler_state.io_queue->mutex); // Bloquea el mutex para el acceso a la cola de E/S
     
-    if (scheduler_state.io_queue->size < MAX_IO_QUEUE_SIZE) { // Si la cola de E/S no está llena
+    bool new_earliest = false; // Indica si la nueva entrada es la próxima en vencer
+    bool overflow = !io_queue_reserve(scheduler_state.io_queue); // La cola de E/S no puede crecer más
+    if (!overflow) { // Si la cola de E/S no está llena
         IOQueueEntry* entry = &scheduler_state.io_queue->entries[scheduler_state.io_queue->size]; // Obtiene el índice del proceso en la cola de E/S
         entry->process = process; // Añade el proceso a la cola de E/S
-        process->pcb->current_io_wait_time = random_range(MIN_IO_WAIT, MAX_IO_WAIT); // Obtiene el tiempo promedio de espera de E/S
+        process->pcb->current_io_wait_time = rng_range(&scheduler_state.rng, MIN_IO_WAIT, MAX_IO_WAIT); // Obtiene el tiempo promedio de espera de E/S
         entry->wait_time = process->pcb->current_io_wait_time; // Añade el tiempo promedio de espera de E/S a la cola de E/S
-        entry->start_time = time(NULL); // Obtiene la hora de inicio de la cola de E/S
+        entry->start_time = clock_now_ns(); // Obtiene la hora de inicio de la cola de E/S
+        entry->deadline = entry->start_time + clock_ms_to_ns(entry->wait_time); // Calcula el momento exacto en que termina la E/S
         scheduler_state.io_queue->size++; // Incrementa el número de procesos en la cola de E/S
+        io_queue_sift_up(scheduler_state.io_queue, scheduler_state.io_queue->size - 1); // Ordena la entrada por fecha límite (O(log n))
+        new_earliest = scheduler_state.io_queue->entries[0].process == process; // El hilo de E/S debe recalcular su espera
+        trace_event(TRACE_IO_START, process->index, process->slot, entry->wait_time, process->hive->bees_and_honey_count); // Registra el inicio de E/S
+        if (clock_is_virtual()) { // En tiempo virtual no hay hilo de E/S
+            sim_schedule(entry->deadline, io_completion_event, NULL); // La cola de eventos completa la E/S en su fecha límite
+        }
         
-        printf("Proceso %d añadido a cola de E/S. Tiempo de espera: %d ms\n", process->index, entry->wait_time); // Imprime un mensaje de debug
+        log_printf("Proceso %d añadido a cola de E/S. Tiempo de espera: %d ms\n", process->index, entry->wait_time); // Imprime un mensaje de debug
     }
 
     scheduler_state.process_table->io_waiting_processes = scheduler_state.io_queue->size; // Actualiza la tabla de procesos
     
     pthread_mutex_unlock(&scheduler_state.io_queue->mutex); // Desbloquea el mutex para el acceso a la cola de E/S
-    pthread_cond_signal(&scheduler_state.io_queue->condition); // Señaliza la cola de E/S
+    if (overflow) { // El proceso no puede esperar su E/S
+        atomic_fetch_add(&scheduler_state.io_overflows, 1); // Cuenta el desbordamiento
+        log_printf("Cola de E/S llena: proceso %d vuelve a listos sin E/S\n", process->index); // Imprime un mensaje de debug
+        publish_ready_process(process); // No se pierde: el planificador lo devuelve a listos
+    }
+    if (new_earliest) { // Solo se despierta al hilo de E/S si cambia la próxima fecha límite
+        pthread_cond_signal(&scheduler_state.io_queue->condition); // Señaliza la cola de E/S
+    }
 }
 
-//Se elimina un proceso a la cola de entrada/salida
+//Se elimina un proceso a la cola de entrada/salida (el llamador debe tener el mutex de la cola)
 void remove_from_io_queue(int index) {
-    for (int j = index; j < scheduler_state.io_queue->size - 1; j++) { // Recorre la cola de E/S
-        scheduler_state.io_queue->entries[j] = scheduler_state.io_queue->entries[j + 1]; // Mueve el proceso a la posición anterior
+    IOQueue* queue = scheduler_state.io_queue; // Obtiene la cola de E/S
+    queue->size--; // Decrementa el número de procesos en la cola de E/S
+    if (index < queue->size) { // Si no era la última entrada
+        queue->entries[index] = queue->entries[queue->size]; // Mueve la última entrada al hueco
+        io_queue_sift_down(queue, index); // Restaura el orden hacia abajo
+        io_queue_sift_up(queue, index); // O hacia arriba, según corresponda
     }
-    scheduler_state.io_queue->size--; // Decrementa el número de procesos en la cola de E/S
-    scheduler_state.process_table->io_waiting_processes = scheduler_state.io_queue->size; // Actualiza la tabla de procesos
+    scheduler_state.process_table->io_waiting_processes = queue->size; // Actualiza la tabla de procesos
 }
 
-// Este procesa los procesos en la cola de entrada/salida.
+// Completa en un solo lote todas las E/S cuya fecha límite ya pasó
 void process_io_queue(void) {
     pthread_mutex_lock(&scheduler_state.io_queue->mutex); // Bloquea el mutex para el acceso a la cola de E/S
     
-    time_t current_time = time(NULL); // Obtiene la hora actual
-    int i = 0; // Índice del proceso en la cola de E/S
-    
-    while (i < scheduler_state.io_queue->size) { // Recorre la cola de E/S
-        IOQueueEntry* entry = &scheduler_state.io_queue->entries[i]; // Obtiene el índice del proceso en la cola de E/S
-        double elapsed_ms = difftime(current_time, entry->start_time) * 1000; // Obtiene el tiempo transcurrido desde la última vez que se inició el proceso
-        
-        if (elapsed_ms >= entry->wait_time) { // Si el tiempo transcurrido es mayor o igual al tiempo promedio de espera de E/S
-            ProcessInfo* process = entry->process; // Obtiene el proceso
-            
-            remove_from_io_queue(i); // Eliminar de la cola de E/S
-            
-            update_process_state(process, READY); // Actualizar estado y añadir a cola de listos
-            add_to_ready_queue(process); // Añadir al cola de listos
-            
-            printf("Proceso %d completó E/S\n", process->index); // Imprime un mensaje de debug
-        } else {
-            i++; // Incrementa el índice del proceso en la cola de E/S
-        }
+    clock_ns_t now = clock_now_ns(); // Obtiene la hora actual
+    while (scheduler_state.io_queue->size > 0 && io_deadline_reached(scheduler_state.io_queue->entries[0].deadline, now)) { // Solo se miran las entradas vencidas de la cima
+        ProcessInfo* completed = scheduler_state.io_queue->entries[0].process; // Proceso que completó su E/S
+        remove_from_io_queue(0); // Eliminar de la cola de E/S
+        publish_ready_process(completed); // Sin bloqueo: el planificador lo pasará a listos en su próxima decisión (el lote no necesita un búfer acotado)
+        log_printf("Proceso %d completó E/S\n", completed->index); // Imprime un mensaje de debug
     }
     
     pthread_mutex_unlock(&scheduler_state.io_queue->mutex); // Desbloquea el mutex para el acceso a la cola de E/S
@@ -171,70 +480,65 @@ void process_io_queue(void) {
 void* io_manager_thread(void* arg) {
     (void)arg; // Ignora el argumento pasado al hilo
     
-    while (scheduler_state.running) { // Mientras la cola de E/S no esté vacía y la cola de listos no esté llena
-        pthread_mutex_lock(&scheduler_state.io_queue->mutex); // Bloquea el mutex para el acceso a la cola de E/S
-        
-        while (scheduler_state.io_queue->size == 0 && scheduler_state.running) { // Mientras la cola de E/S esté vacía y la cola de listos no esté llena
-            pthread_cond_wait(&scheduler_state.io_queue->condition, &scheduler_state.io_queue->mutex); // Espera a que se añada un proceso a la cola de E/S
+    pthread_mutex_lock(&scheduler_state.io_queue->mutex); // Bloquea el mutex para el acceso a la cola de E/S
+    while (scheduler_state.running) { // Mientras el planificador esté en ejecución
+        if (scheduler_state.io_queue->size == 0) { // Sin E/S pendientes
+            pthread_cond_wait(&scheduler_state.io_queue->condition, &scheduler_state.io_queue->mutex); // Duerme hasta que se añada un proceso a la cola de E/S
+            continue; // Reevalúa el estado
         }
         
-        if (!scheduler_state.running) { // Si la cola de E/S está vacía y la cola de listos no está llena
-            pthread_mutex_unlock(&scheduler_state.io_queue->mutex); // Desbloquea el mutex para el acceso a la cola de E/S
-            break;
+        clock_ns_t deadline = scheduler_state.io_queue->entries[0].deadline; // Próxima fecha límite
+        if (!io_deadline_reached(deadline, clock_now_ns())) { // Aún no vence ninguna E/S
+            struct timespec wake_at = clock_to_timespec(deadline); // Fecha límite como timespec absoluto
+            pthread_cond_timedwait(&scheduler_state.io_queue->condition, &scheduler_state.io_queue->mutex, &wake_at); // Duerme exactamente hasta la próxima fecha límite
+            continue; // Reevalúa (pudo llegar una E/S más próxima)
         }
         
         pthread_mutex_unlock(&scheduler_state.io_queue->mutex); // Desbloquea el mutex para el acceso a la cola de E/S
-        process_io_queue(); // Procesa la cola de E/S
-        delay_ms(1); // Espera 1 ms
+        process_io_queue(); // Completa todas las E/S vencidas en un lote
+        pthread_mutex_lock(&scheduler_state.io_queue->mutex); // Vuelve a bloquear el mutex para esperar
     }
+    pthread_mutex_unlock(&scheduler_state.io_queue->mutex); // Desbloquea el mutex para el acceso a la cola de E/S
     
     return NULL;
 }
 
-// Gestión de FSJ
-void sort_ready_queue_fsj(void) {
-    ReadyQueue* queue = scheduler_state.ready_queue; // Obtiene la cola de listos
-    
-    for (int i = 0; i < queue->size - 1; i++) { // Recorre la cola de listos
-        for (int j = 0; j < queue->size - i - 1; j++) { // Recorre la cola de listos
-            ProcessInfo* p1 = queue->processes[j]; // Obtiene el proceso 1
-            ProcessInfo* p2 = queue->processes[j + 1]; // Obtiene el proceso 2
-            
-            if (p1->hive->bees_and_honey_count > p2->hive->bees_and_honey_count) { // Si el número de abejas es mayor que el de la colmena
-                ProcessInfo* temp = queue->processes[j]; // Intercambia los procesos
-                queue->processes[j] = queue->processes[j + 1]; // Intercambia los procesos
-                queue->processes[j + 1] = temp; // Intercambia los procesos
-            }
-        }
-    }
-}
-
+// Gestión de la expulsión
 //Alternancia del proceso
-bool should_preempt_fsj(ProcessInfo* new_process) {
-    if (!new_process || !scheduler_state.active_process) return false; // Si no hay bloque de control de procesos o proceso activo, devuelve falso
+bool should_preempt(DispatchSlot* slot, ProcessInfo* new_process) {
+    if (!new_process || !slot->active_process) return false; // Si no hay bloque de control de procesos o proceso activo, devuelve falso
     
-    return new_process->hive->bees_and_honey_count < scheduler_state.active_process->hive->bees_and_honey_count; // Retorna verdadero si el número de abejas del nuevo proceso es menor que el de la colmena actual
+    return scheduler_state.policy->preempt_check(new_process, slot->active_process); // La política decide si el candidato desplaza al activo
 }
 
-//Manejo de la alternancia con FSJ 
-void handle_fsj_preemption(void) {
-    if (!scheduler_state.active_process) return; // Si no hay proceso activo, devuelve
-    
-    pthread_mutex_lock(&scheduler_state.scheduler_mutex); // Bloquea el mutex para el acceso al proceso activo
-    
-    ProcessInfo* current = scheduler_state.active_process; // Obtiene el proceso activo
-    ProcessInfo* next = get_next_ready_process(); // Obtiene el siguiente proceso en la cola de listos
+//Manejo de la expulsión en cada núcleo
+void handle_preemption(void) {
+    drain_ready_handoff(); // Los procesos recién listos también compiten por expulsar al activo
+    pthread_mutex_lock(&scheduler_state.scheduler_mutex); // Bloquea el mutex para el acceso a los procesos activos
     
-    if (next && should_preempt_fsj(next)) { // Si el siguiente proceso es menor que el de la colmena actual y debe ser preemptivo
-        preempt_current_process(READY); // Preemptiva el proceso activo
-        add_to_ready_queue(current); // Añade el proceso activo a la cola de listos
-        scheduler_state.active_process = next; // Actualiza el proceso activo
-        resume_process(next); // Resume el proceso
-    } else if (next) { // Si el siguiente proceso es menor que el de la colmena actual
-        add_to_ready_queue(next); // Añade el siguiente proceso a la cola de listos
+    for (int i = 0; i < scheduler_state.slot_count; i++) { // Recorre los núcleos
+        DispatchSlot* slot = &scheduler_state.slots[i]; // Núcleo actual
+        if (!slot->active_process) continue; // Si no hay proceso activo, no hay nada que desplazar
+        
+        ProcessInfo* current = slot->active_process; // Obtiene el proceso activo
+        ProcessInfo* next = NULL; // Siguiente proceso en la cola local
+        
+        pthread_mutex_lock(&slot->ready_queue->mutex); // Bloquea el mutex para el acceso a la cola de listos
+        if (!is_queue_empty(slot->ready_queue) && should_preempt(slot, slot->ready_queue->processes[0])) { // Consulta la cima sin extraerla
+            next = slot->ready_queue->processes[0]; // El más pequeño debe desplazar al activo
+            ready_queue_remove_at(slot->ready_queue, 0); // Solo entonces se extrae de la cola
+        }
+        pthread_mutex_unlock(&slot->ready_queue->mutex); // Desbloquea el mutex para el acceso a la cola de listos
+        
+        if (next) { // Si la política indica que el candidato debe desplazar al activo
+            preempt_current_process(slot, READY); // Preemptiva el proceso activo
+            add_to_ready_queue(current); // Añade el proceso activo a la cola de listos
+            slot->active_process = next; // Actualiza el proceso activo
+            resume_process(next); // Resume el proceso
+        }
     }
     
-    pthread_mutex_unlock(&scheduler_state.scheduler_mutex); // Desbloquea el mutex para el acceso al proceso activo
+    pthread_mutex_unlock(&scheduler_state.scheduler_mutex); // Desbloquea el mutex para el acceso a los procesos activos
 }
 
 // Gestión de procesos
@@ -242,173 +546,346 @@ void update_process_state(ProcessInfo* process, ProcessState new_state) {
     if (!process || !process->pcb) return; // Si no hay bloque de control de procesos o bloque de control de procesos de proceso, devuelve
     
     ProcessState old_state = process->pcb->state; // Obtiene el estado anterior del proceso
+    double ready_wait_before = process->pcb->total_ready_wait_time; // Espera en listos acumulada antes de la transición
+    double io_wait_before = process->pcb->total_io_wait_time; // Espera de E/S acumulada antes de la transición
     update_pcb_state(process->pcb, new_state, process->hive); // Actualiza el estado del bloque de control de procesos
+    quantum_controller_record(&scheduler_state.controller, old_state, new_state, process->pcb->total_ready_wait_time - ready_wait_before, process->pcb->total_io_wait_time - io_wait_before); // El controlador mide lo que sumó el PCB
+    
+    if (new_state == RUNNING && old_state != RUNNING) { // Despacho
+        trace_event(TRACE_DISPATCH, process->index, process->slot, 0, process->hive->bees_and_honey_count); // Registra el despacho
+    } else if (old_state == RUNNING && new_state == READY) { // Expulsión
+        trace_event(TRACE_PREEMPT, process->index, process->slot, 0, process->hive->bees_and_honey_count); // Registra la expulsión
+        atomic_fetch_add(&scheduler_state.preemption_count, 1); // Cuenta la expulsión para las métricas
+    } else if (old_state == WAITING && new_state == READY) { // Fin de E/S
+        trace_event(TRACE_IO_END, process->index, process->slot, process->pcb->current_io_wait_time, process->hive->bees_and_honey_count); // Registra el fin de E/S
+    }
     
     if (new_state == RUNNING) { // Si el nuevo estado es RUNNING
-        process->last_quantum_start = time(NULL); // Obtiene la hora de inicio del quantum
+        process->last_quantum_start = clock_now_ns(); // Obtiene la hora de inicio del quantum
     } else if (old_state == RUNNING && new_state == READY) { // Si el estado anterior era RUNNING y el nuevo es READY
         process->last_quantum_start = 0; // Obtiene la hora de inicio del quantum
     }
 }
 
 // Gestión principal de planificación
-void preempt_current_process(ProcessState new_state) {
-    if (scheduler_state.active_process) { // Si hay proceso activo
-        ProcessInfo* process = scheduler_state.active_process; // Obtiene el proceso activo
-        update_process_state(process, new_state); // Actualiza el estado del proceso
-        scheduler_state.active_process = NULL; // Libera el proceso activo
+void preempt_current_process(DispatchSlot* slot, ProcessState new_state) {
+    if (slot->active_process) { // Si hay proceso activo
+        ProcessInfo* process = slot->active_process; // Obtiene el proceso activo
+        update_process_state(process, new_state); // Actualiza el estado del proceso (un ciclo encolado ya no trabajará)
+        atomic_store(&process->dispatched_at, 0); // Estaciona la colmena: descarta el despacho no atendido
+        slot->active_process = NULL; // Libera el proceso activo
     }
 }
 
 void resume_process(ProcessInfo* process) {
     if (!process) return; // Si no hay bloque de control de procesos, devuelve
     update_process_state(process, RUNNING); // Actualiza el estado del proceso
+    process->last_account_time = process->last_quantum_start; // La contabilidad de CPU empieza con el despacho
+    atomic_store(&process->dispatched_at, clock_now_ns()); // Marca el despacho para medir la latencia
+    if (clock_is_virtual()) return; // En tiempo virtual el ciclo lo encola dispatch_hive_ticks en el mismo paso (uno por paso, repetible con la misma semilla)
+    submit_hive_tick(process); // Despierta a la colmena ahora, sin esperar al siguiente ciclo del planificador
+}
+
+// Registra la latencia entre un despacho y el inicio del ciclo de la colmena
+void record_dispatch_latency(clock_ns_t latency) {
+    atomic_fetch_add(&scheduler_state.dispatch_latency_total_ns, latency); // Acumula la latencia
+    atomic_fetch_add(&scheduler_state.dispatch_count, 1); // Cuenta el despacho
+    
+    long long max = atomic_load(&scheduler_state.dispatch_latency_max_ns); // Máximo actual
+    while (latency > max && !atomic_compare_exchange_weak(&scheduler_state.dispatch_latency_max_ns, &max, latency)) { // Actualiza el máximo sin bloqueo
+    }
+}
+
+// Obtiene la latencia media de despacho en milisegundos
+double average_dispatch_latency_ms(void) {
+    int count = atomic_load(&scheduler_state.dispatch_count); // Despachos medidos
+    if (count == 0) return 0.0; // Sin mediciones
+    return (double)atomic_load(&scheduler_state.dispatch_latency_total_ns) / count / CLOCK_NS_PER_MS; // Media en milisegundos
+}
+
+// Despacha el siguiente proceso disponible en un núcleo libre
+static void dispatch_next_process(DispatchSlot* slot) {
+    ProcessInfo* next = get_next_ready_process(slot); // Obtiene el siguiente proceso
+    if (next) { // Si hay siguiente proceso
+        slot->active_process = next; // Actualiza el proceso activo
+        resume_process(next); // Resume el proceso
+    }
+}
+
+// Contabiliza la CPU consumida por el activo; devuelve true si la política indica que debe ceder el núcleo
+static bool account_running_process(DispatchSlot* slot, clock_ns_t now) {
+    ProcessInfo* current = slot->active_process; // Proceso activo
+    ProcessInfo* next = NULL; // Candidato en la cima de la cola local
+    
+    pthread_mutex_lock(&slot->ready_queue->mutex); // Bloquea el mutex para el acceso a la cola de listos
+    if (!is_queue_empty(slot->ready_queue)) next = slot->ready_queue->processes[0]; // Consulta la cima sin extraerla
+    bool expired = scheduler_state.policy->tick(current, now - current->last_account_time, now - current->last_quantum_start, next); // La política contabiliza el tramo ejecutado
+    pthread_mutex_unlock(&slot->ready_queue->mutex); // Desbloquea el mutex para el acceso a la cola de listos
+    
+    current->last_account_time = now; // El siguiente tramo empieza ahora
+    return expired; // Indica si debe ceder el núcleo
+}
+
+// Planifica un núcleo (el llamador debe tener el mutex del planificador); los procesos que piden E/S se devuelven en io_bound
+static void schedule_slot(DispatchSlot* slot, ProcessInfo** io_bound, int* io_count) {
+    if (!slot->active_process) { // Si no hay proceso activo
+        dispatch_next_process(slot); // Toma trabajo local o robado
+        return; // Salir de la función
+    }
+    
+    clock_ns_t now = clock_now_ns(); // Obtiene la hora actual
+    ProcessInfo* current = slot->active_process; // Obtiene el proceso activo
+    
+    bool expired = account_running_process(slot, now); // Contabiliza la CPU consumida desde el último ciclo
+    
+    if (rng_range(&scheduler_state.rng, 1, 100) <= IO_PROBABILITY) { // Verificar si el proceso actual necesita E/S
+        log_printf("Proceso %d requiere E/S\n", current->index); // Imprime un mensaje de debug
+        preempt_current_process(slot, WAITING); // Preemptiva el proceso activo
+        io_bound[(*io_count)++] = current; // Se añade a la cola de E/S tras liberar el mutex del planificador
+        dispatch_next_process(slot); // Ocupa el núcleo con el siguiente proceso
+        return; // Salir de la función
+    }
+    
+    if (expired) { // Si la política indica que el activo debe ceder el núcleo
+        log_printf("%s para proceso %d (núcleo %d)\n", scheduler_state.policy->uses_quantum ? "Quantum expirado" : "Turno cedido", current->index, slot->id); // Imprime un mensaje de debug
+        preempt_current_process(slot, READY); // Preemptiva el proceso activo
+        add_to_ready_queue(current); // Añade el proceso activo a la cola de listos
+        dispatch_next_process(slot); // Ocupa el núcleo con el siguiente proceso
+    }
 }
 
 // Planificación principal
 void schedule_process(void) {
-    pthread_mutex_lock(&scheduler_state.scheduler_mutex); // Bloquea el mutex para el acceso al proceso activo
+    ProcessInfo* io_bound[MAX_DISPATCH_SLOTS]; // Procesos que piden E/S en esta pasada (como mucho uno por núcleo)
+    int io_count = 0; // Número de procesos que piden E/S
     
-    if (!scheduler_state.active_process) { // Si no hay proceso activo
-        ProcessInfo* next = get_next_ready_process(); // Obtiene el siguiente proceso
-        if (next) {
-            scheduler_state.active_process = next; // Actualiza el proceso activo
-            resume_process(next); // Resume el proceso
-        }
-    } else { // Si hay proceso activo
-        time_t now = time(NULL); // Obtiene la hora actual
-        ProcessInfo* current = scheduler_state.active_process; // Obtiene el proceso activo
-        
-        if (random_range(1, 100) <= IO_PROBABILITY) { // Verificar si el proceso actual necesita E/S
-            printf("Proceso %d requiere E/S\n", current->index); // Imprime un mensaje de debug
-            preempt_current_process(WAITING); // Preemptiva el proceso activo
-            add_to_io_queue(current); // Añade el proceso activo a la cola de E/S
-            
-            ProcessInfo* next = get_next_ready_process(); // Obtiene el siguiente proceso
-            if (next) { // Si hay siguiente proceso
-                scheduler_state.active_process = next; // Actualiza el proceso activo
-                resume_process(next); // Resume el proceso
-            }
-            pthread_mutex_unlock(&scheduler_state.scheduler_mutex); // Desbloquea el mutex para el acceso al proceso activo
-            return; // Salir de la función
-        }
-        
-        if (scheduler_state.current_policy == ROUND_ROBIN) { // Verificar quantum en RR
-            double elapsed = difftime(now, current->last_quantum_start); // Obtiene el tiempo transcurrido desde la última vez que se inició el quantum
-            if (elapsed >= scheduler_state.current_quantum) { // Si ha transcurrido el tiempo de quantum
-                printf("Quantum expirado para proceso %d\n", current->index); // Imprime un mensaje de debug
-                preempt_current_process(READY); // Preemptiva el proceso activo
-                add_to_ready_queue(current); // Añade el proceso activo a la cola de listos
-                
-                ProcessInfo* next = get_next_ready_process(); // Obtiene el siguiente proceso
-                if (next) { // Si hay siguiente proceso
-                    scheduler_state.active_process = next; // Actualiza el proceso activo
-                    resume_process(next); // Resume el proceso
-                }
-            }
+    drain_ready_handoff(); // Encola en lote los fines de E/S y las colmenas nuevas
+    
+    pthread_mutex_lock(&scheduler_state.scheduler_mutex); // Bloquea el mutex para el acceso a los procesos activos
+    
+    for (int i = 0; i < scheduler_state.slot_count; i++) { // Recorre los núcleos
+        schedule_slot(&scheduler_state.slots[i], io_bound, &io_count); // Cada núcleo aplica la política por separado
+    }
+    
+    pthread_mutex_unlock(&scheduler_state.scheduler_mutex); // Desbloquea el mutex para el acceso a los procesos activos
+    
+    for (int i = 0; i < io_count; i++) { // Sin ningún mutex del planificador tomado
+        add_to_io_queue(io_bound[i]); // Añade el proceso a la cola de E/S
+    }
+}
+
+// Encola un ciclo de trabajo para la colmena activa de cada núcleo
+void dispatch_hive_ticks(void) {
+    pthread_mutex_lock(&scheduler_state.scheduler_mutex); // Bloquea el mutex para el acceso a los procesos activos
+    
+    for (int i = 0; i < scheduler_state.slot_count; i++) { // Recorre los núcleos
+        if (scheduler_state.slots[i].active_process) { // Solo las colmenas despachadas trabajan
+            submit_hive_tick(scheduler_state.slots[i].active_process); // El pool ejecuta el ciclo de la colmena
         }
     }
     
-    pthread_mutex_unlock(&scheduler_state.scheduler_mutex); // Desbloquea el mutex para el acceso al proceso activo
+    pthread_mutex_unlock(&scheduler_state.scheduler_mutex); // Desbloquea el mutex para el acceso a los procesos activos
 }
 
 // Control de política
 void update_quantum(void) {
-    time_t current_time = time(NULL); // Obtiene la hora actual
-    if (difftime(current_time, scheduler_state.last_quantum_update) >= QUANTUM_UPDATE_INTERVAL) { // Si ha transcurrido un tiempo suficiente desde la última actualización de quantum
-        scheduler_state.current_quantum = random_range(MIN_QUANTUM, MAX_QUANTUM); // Obtiene un nuevo quantum aleatorio
+    if (scheduler_state.controller.mode == QUANTUM_MODE_ADAPTIVE) return; // En modo adaptativo el quantum lo ajusta el controlador
+    clock_ns_t current_time = clock_now_ns(); // Obtiene la hora actual
+    if (clock_elapsed_seconds(scheduler_state.last_quantum_update, current_time) >= QUANTUM_UPDATE_INTERVAL) { // Si ha transcurrido un tiempo suficiente desde la última actualización de quantum
+        scheduler_state.current_quantum = rng_range(&scheduler_state.rng, MIN_QUANTUM, MAX_QUANTUM); // Obtiene un nuevo quantum aleatorio
         scheduler_state.last_quantum_update = current_time; // Actualiza la hora de última actualización de quantum
-        printf("\nNuevo Quantum: %d segundos\n", scheduler_state.current_quantum); // Imprime un mensaje de debug
+        trace_event(TRACE_QUANTUM, TRACE_NO_PROCESS, 0, scheduler_state.current_quantum, 0); // Registra el cambio de quantum
+        log_printf("\nNuevo Quantum: %d ms\n", scheduler_state.current_quantum); // Imprime un mensaje de debug
     }
 }
 
-// Cambio de política de planificación 
-void switch_scheduling_policy(void) {
+// Cambio a una política de planificación concreta
+void set_scheduling_policy(SchedulingPolicy policy) {
     pthread_mutex_lock(&scheduler_state.scheduler_mutex); // Bloquea el mutex para el acceso al proceso activo
+    for (int i = 0; i < scheduler_state.slot_count; i++) { // El criterio de los montículos cambia junto con la política
+        pthread_mutex_lock(&scheduler_state.slots[i].ready_queue->mutex); // Bloquea cada cola local
+    }
     
-    scheduler_state.current_policy = (scheduler_state.current_policy == ROUND_ROBIN) ? SHORTEST_JOB_FIRST : ROUND_ROBIN; // Cambia la política de planificación
-    scheduler_state.last_policy_switch = time(NULL); // Obtiene la hora de última vez que cambió de política
+    scheduler_state.policy = get_policy_ops(policy); // Cambia las operaciones de planificación
+    scheduler_state.current_policy = scheduler_state.policy->id; // Cambia la política de planificación
+    scheduler_state.last_policy_switch = clock_now_ns(); // Obtiene la hora de última vez que cambió de política
     
-    if (scheduler_state.current_policy == SHORTEST_JOB_FIRST) { // Si la política es FSJ
-        sort_ready_queue_fsj(); // Ordena la cola de listos
+    for (int i = scheduler_state.slot_count - 1; i >= 0; i--) { // Recorre los núcleos en orden inverso
+        rebuild_ready_queue(scheduler_state.slots[i].ready_queue); // Reordena la cola local con el nuevo criterio
+        pthread_mutex_unlock(&scheduler_state.slots[i].ready_queue->mutex); // Desbloquea la cola local
     }
     
-    printf("\nCambiando política de planificación a: %s\n", scheduler_state.current_policy == ROUND_ROBIN ? "Round Robin" : "Shortest Job First (FSJ)"); // Imprime un mensaje de debug
+    trace_event(TRACE_POLICY, TRACE_NO_PROCESS, 0, scheduler_state.current_policy, 0); // Registra el cambio de política
+    log_printf("\nCambiando política de planificación a: %s\n", scheduler_state.policy->name); // Imprime un mensaje de debug
     
     pthread_mutex_unlock(&scheduler_state.scheduler_mutex); // Desbloquea el mutex para el acceso al proceso activo
 }
 
+// Política a la que lleva la alternancia entre Round Robin y FSJ
+static SchedulingPolicy alternate_policy(void) {
+    return scheduler_state.current_policy == ROUND_ROBIN ? SHORTEST_JOB_FIRST : ROUND_ROBIN; // La otra política de la alternancia
+}
+
+// Alternancia periódica entre Round Robin y FSJ
+void switch_scheduling_policy(void) {
+    set_scheduling_policy(alternate_policy()); // Cambia la política de planificación
+}
+
+// Ajusta quantum y política con las medidas de la última ventana (modo adaptativo)
+static void adapt_scheduling(clock_ns_t current_time) {
+    QuantumController* controller = &scheduler_state.controller; // Controlador del planificador
+    if (!quantum_controller_sample(controller, scheduler_state.current_policy, current_time)) return; // Sin ventana nueva no se decide nada
+    
+    if (scheduler_state.policy->uses_quantum) { // Solo si la política usa quantum
+        int quantum = quantum_controller_tune_quantum(controller, scheduler_state.current_quantum); // Quantum según las esperas medidas
+        if (quantum != scheduler_state.current_quantum) { // Si el quantum cambia
+            scheduler_state.current_quantum = quantum; // Aplica el nuevo quantum
+            scheduler_state.last_quantum_update = current_time; // Actualiza la hora de última actualización de quantum
+            trace_event(TRACE_QUANTUM, TRACE_NO_PROCESS, 0, quantum, 0); // Registra el cambio de quantum
+            log_printf("\nNuevo Quantum (adaptativo): %d ms - espera en listos %.0f ms, expulsiones %.0f%%\n", quantum, controller->ready_wait_ms, controller->switch_ratio * 100.0); // Imprime un mensaje de debug
+        }
+    }
+    
+    if (scheduler_state.auto_switch_policy && clock_elapsed_seconds(scheduler_state.last_policy_switch, current_time) >= POLICY_SWITCH_THRESHOLD && quantum_controller_should_switch(controller, scheduler_state.current_policy, alternate_policy())) { // Tras el tiempo mínimo en la política, solo si la otra espera menos
+        switch_scheduling_policy(); // Cambia la política de planificación
+    }
+}
+
+// Una decisión completa del planificador
+void scheduler_step(void) {
+    clock_ns_t current_time = clock_coarse_now_ns(); // Obtiene la hora actual (basta la lectura aproximada para umbrales de segundos)
+    
+    if (scheduler_state.controller.mode == QUANTUM_MODE_ADAPTIVE) { // En modo adaptativo decide el controlador
+        adapt_scheduling(current_time); // Ajusta quantum y política con las medidas
+    } else if (scheduler_state.auto_switch_policy && clock_elapsed_seconds(scheduler_state.last_policy_switch, current_time) >= POLICY_SWITCH_THRESHOLD) { // Si ha transcurrido un tiempo suficiente desde la última vez que cambió de política
+        switch_scheduling_policy(); // Cambia la política de planificación
+    }
+    
+    if (scheduler_state.policy->uses_quantum) { // Si la política usa quantum
+        update_quantum(); // Actualiza el quantum
+    } else { // Si la política es expulsiva
+        handle_preemption(); // Maneja la expulsión según la política
+    }
+    
+    for (int i = 0; i < scheduler_state.slot_count; i++) { // Envejece las colas locales (evita la inanición de los que nunca se reencolan)
+        age_ready_queue(scheduler_state.slots[i].ready_queue, clock_now_ns()); // La política decide
+    }
+    schedule_process(); // Planifica el siguiente proceso
+    dispatch_hive_ticks(); // Las colmenas en ejecución trabajan un ciclo en el pool
+}
+
 void* policy_control_thread(void* arg) {
     (void)arg; // Ignora el argumento pasado al hilo
     
     while (scheduler_state.running) { // Mientras la cola de E/S no esté vacía y la cola de listos no esté llena
-        time_t current_time = time(NULL); // Obtiene la hora actual
-        
-        if (difftime(current_time, scheduler_state.last_policy_switch) >= POLICY_SWITCH_THRESHOLD) { // Si ha transcurrido un tiempo suficiente desde la última vez que cambió de política
-            switch_scheduling_policy(); // Cambia la política de planificación
-        }
-        
-        if (scheduler_state.current_policy == ROUND_ROBIN) { // Si la política es RR 
-            update_quantum(); // Actualiza el quantum
-        } else { // Si la política es FSJ
-            handle_fsj_preemption(); // Maneja la alternancia con FSJ
-        }
-        
-        schedule_process(); // Planifica el siguiente proceso
-        delay_ms(1000); // Espera 1 segundo
+        scheduler_step(); // Decide y despacha
+        delay_ms(SCHEDULER_TICK_MS); // Espera hasta la siguiente decisión
     }
     
     return NULL; // Devuelve NULL
 }
 
+// Ciclo del planificador en tiempo virtual: el tiempo no avanza hasta que terminan los ciclos de las colmenas
+static void scheduler_tick_event(void* arg) {
+    (void)arg; // Sin uso
+    scheduler_step(); // Decide y despacha
+    thread_pool_wait_idle(&scheduler_state.worker_pool); // Las colmenas trabajan con el tiempo detenido
+}
+
+// Obtiene el número de núcleos de despacho (uno por CPU en línea)
+static int detect_dispatch_slots(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN); // CPUs disponibles
+    if (cpus < 1) cpus = 1; // Al menos un núcleo
+    if (cpus > MAX_DISPATCH_SLOTS) cpus = MAX_DISPATCH_SLOTS; // Sin superar el máximo
+    return (int)cpus; // Devuelve el número de núcleos
+}
+
 // Inicialización y limpieza
-void init_scheduler(void) {
+void init_scheduler(SchedulingPolicy policy, bool auto_switch_policy, QuantumMode quantum_mode, int process_limit) {
     // Inicializar estado
-    scheduler_state.current_policy = ROUND_ROBIN; // Inicializa la política de planificación
-    scheduler_state.current_quantum = random_range(MIN_QUANTUM, MAX_QUANTUM); // Inicializa el quantum
-    scheduler_state.last_quantum_update = time(NULL); // Obtiene la hora de última actualización de quantum
-    scheduler_state.last_policy_switch = time(NULL); // Obtiene la hora de última vez que cambió de política
+    scheduler_state.current_policy = policy; // Inicializa la política de planificación
+    scheduler_state.policy = get_policy_ops(scheduler_state.current_policy); // Operaciones de la política inicial
+    scheduler_state.auto_switch_policy = auto_switch_policy; // Indica si se alterna de política automáticamente
+    rng_stream_init(&scheduler_state.rng, RNG_STREAM_SCHEDULER); // Flujo aleatorio propio del planificador
+    scheduler_state.current_quantum = rng_range(&scheduler_state.rng, MIN_QUANTUM, MAX_QUANTUM); // Inicializa el quantum
+    scheduler_state.last_quantum_update = clock_now_ns(); // Obtiene la hora de última actualización de quantum
+    scheduler_state.last_policy_switch = clock_now_ns(); // Obtiene la hora de última vez que cambió de política
     scheduler_state.running = true; // Inicializa el estado del planificador
-    scheduler_state.active_process = NULL; // Inicializa el proceso activo
+    init_quantum_controller(&scheduler_state.controller, quantum_mode, scheduler_state.last_quantum_update); // Aleatorio o ajustado con las esperas medidas
+    atomic_store(&scheduler_state.dispatch_latency_total_ns, 0); // Sin latencias medidas
+    atomic_store(&scheduler_state.dispatch_latency_max_ns, 0); // Sin latencia máxima
+    atomic_store(&scheduler_state.dispatch_count, 0); // Sin despachos medidos
+    atomic_store(&scheduler_state.preemption_count, 0); // Sin expulsiones
+    scheduler_state.process_limit = process_limit; // Máximo de procesos (tope de las colas)
+    atomic_store(&scheduler_state.ready_overflows, 0); // Sin desbordamientos
+    atomic_store(&scheduler_state.io_overflows, 0); // Sin desbordamientos
+    atomic_store(&scheduler_state.spawn_overflows, 0); // Sin desbordamientos
+    atomic_store(&scheduler_state.ready_handoff.head, NULL); // Pila de traspaso vacía
+    atomic_store(&scheduler_state.ready_handoff.pending, 0); // Sin procesos pendientes
     
     // Inicializa mutex y semáforos
     pthread_mutex_init(&scheduler_state.scheduler_mutex, NULL);
     sem_init(&scheduler_state.scheduler_sem, 0, 1);
     
-    scheduler_state.ready_queue = malloc(sizeof(ReadyQueue)); // Inicializa cola de listos
-    scheduler_state.ready_queue->size = 0; // Inicializa el tamaño de la cola de listos
-    pthread_mutex_init(&scheduler_state.ready_queue->mutex, NULL); // Crea el mutex para el acceso a la cola de listos
+    scheduler_state.slot_count = detect_dispatch_slots(); // Un núcleo de despacho por CPU disponible
+    for (int i = 0; i < scheduler_state.slot_count; i++) { // Inicializa cada núcleo
+        DispatchSlot* slot = &scheduler_state.slots[i]; // Núcleo actual
+        slot->id = i; // Número del núcleo
+        slot->active_process = NULL; // Inicializa el proceso activo
+        slot->ready_queue = malloc(sizeof(ReadyQueue)); // Inicializa la cola local de listos
+        init_ready_queue(slot->ready_queue, process_limit); // Vacía; crece hasta el máximo de procesos
+    }
+    
+    init_trace(TRACE_FILE, scheduler_state.slot_count); // Empieza a grabar la traza del planificador
+    trace_event(TRACE_POLICY, TRACE_NO_PROCESS, 0, scheduler_state.current_policy, 0); // Política inicial
+    trace_event(TRACE_QUANTUM, TRACE_NO_PROCESS, 0, scheduler_state.current_quantum, 0); // Quantum inicial
     
     init_io_queue(); // Inicializa cola de E/S
+    init_thread_pool(&scheduler_state.worker_pool, scheduler_state.slot_count); // Un trabajador por núcleo de despacho
     
     scheduler_state.process_table = malloc(sizeof(ProcessTable)); // Inicializa tabla de procesos
     init_process_table(scheduler_state.process_table); // Inicializa la tabla de procesos
     
-    printf("Planificador inicializado - Política: %s, Quantum: %d\n", scheduler_state.current_policy == ROUND_ROBIN ? "Round Robin" : "FSJ", scheduler_state.current_quantum); // Imprime un mensaje de debug
+    log_printf("Planificador inicializado - Política: %s, Quantum: %d, Núcleos: %d\n", scheduler_state.policy->name, scheduler_state.current_quantum, scheduler_state.slot_count); // Imprime un mensaje de debug
     
+    if (clock_is_virtual()) { // En tiempo virtual la cola de eventos sustituye a los hilos
+        sim_schedule_periodic(clock_now_ns(), clock_ms_to_ns(SCHEDULER_TICK_MS), scheduler_tick_event, NULL); // Una decisión por ciclo del planificador
+        return; // Sin hilos de control ni de E/S
+    }
     pthread_create(&scheduler_state.policy_control_thread, NULL, policy_control_thread, NULL); // Inicia los hilos
     pthread_create(&scheduler_state.io_thread, NULL, io_manager_thread, NULL); // Inicia el hilo de E/S
 }
 
-void cleanup_scheduler(void) {
+void stop_scheduler(void) {
+    if (!scheduler_state.running) return; // Ya detenido
     scheduler_state.running = false; // Libera el hilo de E/S
     
     pthread_mutex_lock(&scheduler_state.io_queue->mutex); // DEspierta hilos bloqueados
     pthread_cond_broadcast(&scheduler_state.io_queue->condition); // Señaliza la cola de E/S
     pthread_mutex_unlock(&scheduler_state.io_queue->mutex); // Desbloquea el mutex para el acceso a la cola de E/S
     
-    pthread_join(scheduler_state.policy_control_thread, NULL); // Espera la finalización de los hilos
-    pthread_join(scheduler_state.io_thread, NULL); // Espera a que termine el hilo de E/S
+    if (!clock_is_virtual()) { // Los hilos solo existen en tiempo real
+        pthread_join(scheduler_state.policy_control_thread, NULL); // Espera la finalización de los hilos
+        pthread_join(scheduler_state.io_thread, NULL); // Espera a que termine el hilo de E/S
+    }
+    shutdown_thread_pool(&scheduler_state.worker_pool); // Termina los ciclos pendientes y detiene los trabajadores
+}
+
+void cleanup_scheduler(void) {
+    stop_scheduler(); // Por si no se detuvo antes
+    close_trace(); // Vuelca y cierra la traza
     
     pthread_mutex_destroy(&scheduler_state.scheduler_mutex); // Limpia los recursos
     sem_destroy(&scheduler_state.scheduler_sem); // Libera el semáforo de planificación
     
-    pthread_mutex_destroy(&scheduler_state.ready_queue->mutex);  // Limpia la cola de listos
-    free(scheduler_state.ready_queue); // Libera la cola de listos
+    for (int i = 0; i < scheduler_state.slot_count; i++) { // Limpia las colas locales
+        cleanup_ready_queue(scheduler_state.slots[i].ready_queue);  // Limpia la cola de listos
+        free(scheduler_state.slots[i].ready_queue); // Libera la cola de listos
+    }
     
     free(scheduler_state.process_table); // Limpia la tabla de procesos
     
     cleanup_io_queue(); // Limpia la cola de E/S
     
-    printf("Planificador limpiado correctamente\n"); // Imprime un mensaje de debug
+    log_printf("Planificador limpiado correctamente\n"); // Imprime un mensaje de debug
 }
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include <stdlib.h> // Biblioteca de funciones de uso general
+#include "../include/core/sim.h" // Simulación en tiempo virtual
+#include "../include/core/clock.h" // Reloj monótono
+
+// Instancia de la cola global de eventos
+static SimEventQueue sim_queue;
+
+// Indica si el evento a ocurre antes que b
+static bool sim_event_before(const SimEvent* a, const SimEvent* b) {
+    if (a->time != b->time) return a->time < b->time; // Primero el más próximo
+    return a->sequence < b->sequence; // En empate, el que se programó antes
+}
+
+// Inserta un evento en el montículo (el llamador debe tener el mutex de la cola)
+static void sim_push(SimEvent event) {
+    if (sim_queue.size == sim_queue.capacity) { // Montículo lleno
+        sim_queue.capacity *= 2; // Duplica la capacidad
+        sim_queue.events = realloc(sim_queue.events, sim_queue.capacity * sizeof(SimEvent)); // Amplía el arreglo
+    }
+    event.sequence = sim_queue.next_sequence++; // Orden de inserción
+    
+    int index = sim_queue.size++; // Posición final provisional
+    while (index > 0) { // Sube mientras preceda a su padre
+        int parent = (index - 1) / 2; // Índice del padre
+        if (!sim_event_before(&event, &sim_queue.events[parent])) break; // El padre ya va antes
+        sim_queue.events[index] = sim_queue.events[parent]; // Baja el padre
+        index = parent; // Continúa desde el padre
+    }
+    sim_queue.events[index] = event; // Coloca el evento
+}
+
+// Extrae el próximo evento (el llamador debe tener el mutex de la cola y la cola no puede estar vacía)
+static SimEvent sim_pop(void) {
+    SimEvent top = sim_queue.events[0]; // Próximo evento
+    SimEvent last = sim_queue.events[--sim_queue.size]; // Último elemento
+    int index = 0; // Hueco en la cima
+    while (true) { // Baja el último elemento desde la cima
+        int child = 2 * index + 1; // Hijo izquierdo
+        if (child >= sim_queue.size) break; // Sin hijos
+        if (child + 1 < sim_queue.size && sim_event_before(&sim_queue.events[child + 1], &sim_queue.events[child])) child++; // El hijo derecho va antes
+        if (!sim_event_before(&sim_queue.events[child], &last)) break; // El último ya va antes que sus hijos
+        sim_queue.events[index] = sim_queue.events[child]; // Sube el hijo
+        index = child; // Continúa desde el hijo
+    }
+    if (sim_queue.size > 0) sim_queue.events[index] = last; // Coloca el último elemento
+    return top; // Devuelve el próximo evento
+}
+
+void init_sim_events(void) {
+    sim_queue.capacity = SIM_INITIAL_EVENTS; // Capacidad inicial
+    sim_queue.events = malloc(sim_queue.capacity * sizeof(SimEvent)); // Montículo de eventos
+    sim_queue.size = 0; // Sin eventos
+    sim_queue.next_sequence = 0; // Primer número de inserción
+    pthread_mutex_init(&sim_queue.mutex, NULL); // Mutex de la cola
+}
+
+void cleanup_sim_events(void) {
+    pthread_mutex_destroy(&sim_queue.mutex); // Destruye el mutex
+    free(sim_queue.events); // Libera el montículo
+    sim_queue.events = NULL; // Sin montículo
+    sim_queue.size = 0; // Sin eventos
+}
+
+void sim_schedule(clock_ns_t time, SimEventFn fn, void* arg) {
+    sim_schedule_periodic(time, 0, fn, arg); // Evento sin periodo
+}
+
+void sim_schedule_periodic(clock_ns_t first, clock_ns_t period, SimEventFn fn, void* arg) {
+    SimEvent event = { first, 0, period, fn, arg }; // Evento a programar
+    pthread_mutex_lock(&sim_queue.mutex); // Bloquea el mutex de la cola
+    sim_push(event); // Inserta el evento
+    pthread_mutex_unlock(&sim_queue.mutex); // Desbloquea el mutex de la cola
+}
+
+long long sim_run_until(clock_ns_t end, volatile sig_atomic_t* running) {
+    long long executed = 0; // Eventos ejecutados en esta llamada
+    
+    while (*running) { // Hasta que se pida terminar
+        pthread_mutex_lock(&sim_queue.mutex); // Bloquea el mutex de la cola
+        if (sim_queue.size == 0 || sim_queue.events[0].time > end) { // No quedan eventos antes del final
+            pthread_mutex_unlock(&sim_queue.mutex); // Desbloquea el mutex de la cola
+            break; // Fin de la simulación
+        }
+        SimEvent event = sim_pop(); // Próximo evento
+        if (event.period > 0) { // Evento repetitivo
+            SimEvent next = event; // Siguiente ocurrencia
+            next.time += event.period; // Un periodo después
+            sim_push(next); // Se vuelve a programar
+        }
+        pthread_mutex_unlock(&sim_queue.mutex); // Desbloquea el mutex de la cola (la acción puede programar eventos)
+        
+        clock_advance_to(event.time); // El tiempo salta directamente al evento
+        event.fn(event.arg); // Ejecuta la acción
+        executed++; // Cuenta el evento
+    }
+    
+    if (*running) clock_advance_to(end); // El tiempo termina en el final pedido
+    return executed; // Devuelve los eventos ejecutados
+}
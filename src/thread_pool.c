@@ -0,0 +1,113 @@
+#include <stdio.h> // Biblioteca de entrada/salida estándar
+#include <stdlib.h> // Biblioteca de funciones de uso general
+#include "../include/core/thread_pool.h" // Pool de trabajadores
+
+// Bucle de cada hilo trabajador
+static void* thread_pool_worker(void* arg) {
+    ThreadPool* pool = (ThreadPool*)arg; // Pool al que pertenece el trabajador
+    
+    pthread_mutex_lock(&pool->mutex); // Bloquea el mutex de la cola de tareas
+    while (true) {
+        while (pool->size == 0 && !pool->shutting_down) { // Sin tareas pendientes
+            pthread_cond_wait(&pool->task_available, &pool->mutex); // Duerme hasta que llegue una tarea
+        }
+        if (pool->size == 0 && pool->shutting_down) break; // Cierre con la cola vacía
+        
+        ThreadPoolTask task = pool->tasks[pool->head]; // Toma la tarea más antigua
+        pool->head = (pool->head + 1) % pool->capacity; // Avanza la cabeza de la cola circular
+        pool->size--; // Una tarea pendiente menos
+        pool->active++; // Una tarea más en ejecución
+        
+        pthread_mutex_unlock(&pool->mutex); // La tarea se ejecuta sin el mutex
+        task.function(task.arg); // Ejecuta la tarea
+        pthread_mutex_lock(&pool->mutex); // Vuelve a bloquear el mutex
+        
+        pool->active--; // La tarea terminó
+        if (pool->size == 0 && pool->active == 0) { // El pool quedó ocioso
+            pthread_cond_broadcast(&pool->idle); // Despierta a quien espera el vaciado
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex); // Desbloquea el mutex de la cola de tareas
+    
+    return NULL; // Devuelve NULL
+}
+
+// Duplica la capacidad de la cola circular (el llamador debe tener el mutex)
+static void thread_pool_grow(ThreadPool* pool) {
+    int new_capacity = pool->capacity * 2; // Nueva capacidad
+    ThreadPoolTask* tasks = malloc(sizeof(ThreadPoolTask) * new_capacity); // Nueva cola
+    for (int i = 0; i < pool->size; i++) { // Copia las tareas en orden
+        tasks[i] = pool->tasks[(pool->head + i) % pool->capacity]; // Desenrolla la cola circular
+    }
+    free(pool->tasks); // Libera la cola anterior
+    pool->tasks = tasks; // Usa la nueva cola
+    pool->capacity = new_capacity; // Actualiza la capacidad
+    pool->head = 0; // Las tareas empiezan al principio
+}
+
+void init_thread_pool(ThreadPool* pool, int worker_count) {
+    if (worker_count < 1) worker_count = 1; // Al menos un trabajador
+    if (worker_count > MAX_POOL_WORKERS) worker_count = MAX_POOL_WORKERS; // Sin superar el máximo
+    
+    pool->capacity = THREAD_POOL_INITIAL_CAPACITY; // Capacidad inicial
+    pool->tasks = malloc(sizeof(ThreadPoolTask) * pool->capacity); // Crea la cola de tareas
+    pool->head = 0; // Cola vacía
+    pool->size = 0; // Sin tareas pendientes
+    pool->active = 0; // Sin tareas en ejecución
+    pool->shutting_down = false; // El pool acepta tareas
+    pthread_mutex_init(&pool->mutex, NULL); // Crea el mutex de la cola de tareas
+    pthread_cond_init(&pool->task_available, NULL); // Crea la condición de tareas disponibles
+    pthread_cond_init(&pool->idle, NULL); // Crea la condición de pool ocioso
+    
+    pool->worker_count = 0; // Ningún trabajador arrancado todavía
+    for (int i = 0; i < worker_count; i++) { // Arranca los trabajadores
+        if (pthread_create(&pool->workers[i], NULL, thread_pool_worker, pool) == 0) { // Si se pudo crear el hilo
+            pool->worker_count++; // Cuenta el trabajador
+        }
+    }
+}
+
+bool thread_pool_submit(ThreadPool* pool, ThreadPoolTaskFn function, void* arg) {
+    if (!function) return false; // Sin función no hay tarea
+    
+    pthread_mutex_lock(&pool->mutex); // Bloquea el mutex de la cola de tareas
+    bool accepted = !pool->shutting_down; // Solo se aceptan tareas mientras el pool esté abierto
+    if (accepted) { // Solo se aceptan tareas mientras el pool esté abierto
+        if (pool->size == pool->capacity) { // Cola llena
+            thread_pool_grow(pool); // Duplica la capacidad
+        }
+        ThreadPoolTask* task = &pool->tasks[(pool->head + pool->size) % pool->capacity]; // Hueco al final de la cola
+        task->function = function; // Guarda la función
+        task->arg = arg; // Guarda el argumento
+        pool->size++; // Una tarea pendiente más
+        pthread_cond_signal(&pool->task_available); // Despierta a un trabajador
+    }
+    pthread_mutex_unlock(&pool->mutex); // Desbloquea el mutex de la cola de tareas
+    return accepted; // Indica si la tarea quedó encolada
+}
+
+void thread_pool_wait_idle(ThreadPool* pool) {
+    pthread_mutex_lock(&pool->mutex); // Bloquea el mutex de la cola de tareas
+    while (pool->size > 0 || pool->active > 0) { // Mientras quede trabajo
+        pthread_cond_wait(&pool->idle, &pool->mutex); // Espera a que el pool quede ocioso
+    }
+    pthread_mutex_unlock(&pool->mutex); // Desbloquea el mutex de la cola de tareas
+}
+
+void shutdown_thread_pool(ThreadPool* pool) {
+    pthread_mutex_lock(&pool->mutex); // Bloquea el mutex de la cola de tareas
+    pool->shutting_down = true; // No se aceptan más tareas
+    pthread_cond_broadcast(&pool->task_available); // Despierta a todos los trabajadores
+    pthread_mutex_unlock(&pool->mutex); // Desbloquea el mutex de la cola de tareas
+    
+    for (int i = 0; i < pool->worker_count; i++) { // Espera a cada trabajador (terminan las tareas pendientes)
+        pthread_join(pool->workers[i], NULL); // Une el hilo trabajador
+    }
+    
+    pthread_mutex_destroy(&pool->mutex); // Libera el mutex
+    pthread_cond_destroy(&pool->task_available); // Libera la condición de tareas disponibles
+    pthread_cond_destroy(&pool->idle); // Libera la condición de pool ocioso
+    free(pool->tasks); // Libera la cola de tareas
+    pool->tasks = NULL; // Evita usos posteriores
+    pool->worker_count = 0; // Sin trabajadores
+}
@@ -0,0 +1,103 @@
+#include <stdio.h> // Biblioteca de entrada/salida estándar
+#include <stdlib.h> // Biblioteca de funciones de uso general
+#include <pthread.h> // Biblioteca de hilos
+#include "../include/core/trace.h" // Traza binaria
+#include "../include/core/clock.h" // Reloj monótono
+
+// Estado de la grabación
+static FILE* trace_file = NULL; // Archivo de traza abierto (NULL si no se graba)
+static clock_ns_t trace_start = 0; // Momento de inicio de la traza
+static TraceRecord trace_buffer[TRACE_BUFFER_RECORDS]; // Registros pendientes de escribir
+static int trace_buffered = 0; // Número de registros pendientes
+static pthread_mutex_t trace_mutex = PTHREAD_MUTEX_INITIALIZER; // Mutex para el acceso a la traza
+
+// Escribe los registros pendientes (el llamador debe tener el mutex de la traza)
+static void flush_trace_buffer(void) {
+    if (trace_buffered == 0) return; // Nada que escribir
+    fwrite(trace_buffer, sizeof(TraceRecord), trace_buffered, trace_file); // Escribe el bloque completo de una vez
+    trace_buffered = 0; // Vacía el buffer
+}
+
+bool init_trace(const char* path, int slot_count) {
+    pthread_mutex_lock(&trace_mutex); // Bloquea el mutex para el acceso a la traza
+    
+    trace_file = fopen(path, "wb"); // Abre el archivo de traza
+    if (trace_file) { // Si se pudo abrir el archivo
+        TraceHeader header = { TRACE_MAGIC, TRACE_VERSION, sizeof(TraceRecord), slot_count, 0 }; // Cabecera del archivo
+        fwrite(&header, sizeof(TraceHeader), 1, trace_file); // Escribe la cabecera
+        trace_start = clock_now_ns(); // Los tiempos se guardan relativos al inicio
+        trace_buffered = 0; // Buffer vacío
+    }
+    
+    pthread_mutex_unlock(&trace_mutex); // Desbloquea el mutex para el acceso a la traza
+    return trace_file != NULL; // Indica si la traza está activa
+}
+
+void trace_event(TraceEventType type, int process, int slot, int value, int size) {
+    pthread_mutex_lock(&trace_mutex); // Bloquea el mutex para el acceso a la traza
+    
+    if (trace_file) { // Solo si se está grabando
+        TraceRecord* record = &trace_buffer[trace_buffered++]; // Siguiente registro libre
+        record->time_ns = clock_now_ns() - trace_start; // Momento del evento
+        record->process = process; // Proceso del evento
+        record->value = value; // Dato del evento
+        record->size = size; // Tamaño de la colmena
+        record->slot = (uint16_t)(slot < 0 ? 0 : slot); // Núcleo del proceso
+        record->type = (uint8_t)type; // Tipo de evento
+        record->reserved = 0; // Sin uso
+        if (trace_buffered == TRACE_BUFFER_RECORDS) { // Buffer lleno
+            flush_trace_buffer(); // Escribe el bloque en disco
+        }
+    }
+    
+    pthread_mutex_unlock(&trace_mutex); // Desbloquea el mutex para el acceso a la traza
+}
+
+void close_trace(void) {
+    pthread_mutex_lock(&trace_mutex); // Bloquea el mutex para el acceso a la traza
+    
+    if (trace_file) { // Si se estaba grabando
+        flush_trace_buffer(); // Escribe los registros pendientes
+        fclose(trace_file); // Cierra el archivo
+        trace_file = NULL; // Ya no se graba
+    }
+    
+    pthread_mutex_unlock(&trace_mutex); // Desbloquea el mutex para el acceso a la traza
+}
+
+TraceRecord* load_trace(const char* path, TraceHeader* header, size_t* count) {
+    *count = 0; // Sin registros por defecto
+    FILE* fp = fopen(path, "rb"); // Abre el archivo de traza
+    if (!fp) return NULL; // El archivo no existe
+    
+    if (fread(header, sizeof(TraceHeader), 1, fp) != 1 || header->magic != TRACE_MAGIC || header->version != TRACE_VERSION || header->record_size != sizeof(TraceRecord)) { // Cabecera inválida o de otro formato
+        fclose(fp); // Cierra el archivo
+        return NULL; // No es una traza válida
+    }
+    
+    fseek(fp, 0, SEEK_END); // Va al final para medir el archivo
+    long bytes = ftell(fp) - (long)sizeof(TraceHeader); // Bytes de registros
+    fseek(fp, sizeof(TraceHeader), SEEK_SET); // Vuelve al primer registro
+    
+    size_t capacity = bytes > 0 ? (size_t)bytes / sizeof(TraceRecord) : 0; // Registros completos del archivo
+    TraceRecord* records = malloc((capacity > 0 ? capacity : 1) * sizeof(TraceRecord)); // Arreglo de registros
+    if (records) { // Si hay memoria
+        *count = fread(records, sizeof(TraceRecord), capacity, fp); // Lee todos los registros de una vez
+    }
+    
+    fclose(fp); // Cierra el archivo
+    return records; // Devuelve los registros
+}
+
+const char* trace_event_name(TraceEventType type) {
+    switch (type) { // Convierte el tipo de evento a una cadena legible
+        case TRACE_DISPATCH: return "DISPATCH"; // Despacho
+        case TRACE_PREEMPT: return "PREEMPT"; // Expulsión
+        case TRACE_IO_START: return "IO_START"; // Inicio de E/S
+        case TRACE_IO_END: return "IO_END"; // Fin de E/S
+        case TRACE_SPAWN: return "SPAWN"; // Nacimiento de colmena
+        case TRACE_QUANTUM: return "QUANTUM"; // Cambio de quantum
+        case TRACE_POLICY: return "POLICY"; // Cambio de política
+    }
+    return "UNKNOWN"; // Tipo desconocido
+}
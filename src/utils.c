@@ -5,9 +5,7 @@
 #include <sys/stat.h> // Biblioteca de estado de archivos
 #include "../include/core/utils.h" // Utilidades
 
-int random_range(int min, int max) {
-    return min + rand() % (max - min + 1);// Generar un número aleatorio entre 0 y max-min
-}
+bool quiet_output = false;// Por defecto se imprime la actividad de cada ciclo
 
 void delay_ms(int milliseconds) {// Retrasar el programa por un número de milisegundos
     usleep(milliseconds * 1000);